@@ -0,0 +1,350 @@
+#pragma once
+
+#include "hashmapcore.h"
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+// Hash map for many threads at once. The table is split into a power-of-two
+// number of shards picked by the high bits of the mixed key hash; each shard
+// is a separately locked chaining table with its own size counter and the
+// same growth policy and node pool as ChainedHashMap. Writers take only
+// their shard's mutex. get() takes no lock at all:
+//  - links are atomic and a node is never modified once published (put on
+//    an existing key links in a replacement node), so a reader walking a
+//    chain always sees a consistent entry;
+//  - unlinked nodes and replaced bucket arrays are retired, and freed only
+//    after every reader that might still hold them has left (two-phase
+//    epoch counters per shard);
+//  - a resize relinks nodes in place and bumps a sequence number, and a
+//    lookup that missed while it changed is retried.
+// No steps are recorded; this map is not visualized entry by entry.
+template <typename K, typename V>
+class ConcurrentHashMap {
+    using KeyTraits = HashMapTraits<K>;
+
+public:
+    using KeyType = K;
+    using ValueType = V;
+
+    explicit ConcurrentHashMap(int shardCount = 16, int bucketsPerShard = 16,
+                               const HashMapGrowthPolicy &policy = {}) {
+        while ((1 << shardBits_) < shardCount && shardBits_ < 16) ++shardBits_;
+        const HashMapGrowthPolicy sanitized = policy.sanitized();
+        shards_.reserve(static_cast<size_t>(1) << shardBits_);
+        for (int i = 0; i < (1 << shardBits_); ++i) {
+            shards_.push_back(std::make_unique<Shard>(std::max(1, bucketsPerShard), sanitized));
+        }
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap &) = delete;
+    ConcurrentHashMap &operator=(const ConcurrentHashMap &) = delete;
+
+    // Insert without overwriting; returns true if a new key was added
+    bool insert(const K &key, const V &value) {
+        const size_t hash = hashKey(key);
+        return shardFor(hash).insert(key, value, hash, /*assignIfExists=*/false);
+    }
+
+    // Insert or overwrite; returns true if a new key was added
+    bool put(const K &key, const V &value) {
+        const size_t hash = hashKey(key);
+        return shardFor(hash).insert(key, value, hash, /*assignIfExists=*/true);
+    }
+
+    bool erase(const K &key) {
+        const size_t hash = hashKey(key);
+        return shardFor(hash).erase(key, hash);
+    }
+
+    // Lock-free; returns a copy since the node may be retired right after
+    std::optional<V> get(const K &key) const {
+        const size_t hash = hashKey(key);
+        return shardFor(hash).get(key, hash);
+    }
+
+    bool contains(const K &key) const { return get(key).has_value(); }
+
+    // Not atomic across shards: each shard is emptied under its own lock
+    void clear() {
+        for (auto &shard : shards_) shard->clear();
+    }
+
+    int shardCount() const { return static_cast<int>(shards_.size()); }
+
+    int shardOf(const K &key) const { return shardIndex(hashKey(key)); }
+
+    // Counters are read without locking; while writers run the sum is a
+    // snapshot that may be slightly stale
+    int size() const {
+        int total = 0;
+        for (const auto &shard : shards_) total += shard->size();
+        return total;
+    }
+
+    int shardSize(int shard) const { return shards_[static_cast<size_t>(shard)]->size(); }
+    int shardBucketCount(int shard) const { return shards_[static_cast<size_t>(shard)]->bucketCount(); }
+
+    QVector<int> shardSizes() const {
+        QVector<int> sizes;
+        sizes.reserve(shardCount());
+        for (const auto &shard : shards_) sizes.push_back(shard->size());
+        return sizes;
+    }
+
+private:
+    class Shard {
+    public:
+        Shard(int bucketCount, const HashMapGrowthPolicy &policy)
+            : table_(new Table(bucketCount)), policy_(policy) {}
+
+        // Only called once no other thread uses the map
+        ~Shard() {
+            Table *table = table_.load(std::memory_order_relaxed);
+            for (int i = 0; i < table->count; ++i) {
+                destroyChain(table->heads[i].load(std::memory_order_relaxed));
+            }
+            delete table;
+            freeRetired(retiredNodes_, retiredTables_);
+            freeRetired(graceNodes_, graceTables_);
+        }
+
+        bool insert(const K &key, const V &value, size_t hash, bool assignIfExists) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            maybeGrow();
+
+            Table *table = table_.load(std::memory_order_relaxed);
+            std::atomic<Node *> *link = findLink(table, key, hash);
+            Node *existing = link->load(std::memory_order_relaxed);
+            if (existing) {
+                if (assignIfExists) {
+                    // Readers keep seeing either the old node or its replacement
+                    Node *replacement = pool_.create(key, value, hash, existing->next.load(std::memory_order_relaxed));
+                    link->store(replacement);
+                    retiredNodes_.push_back(existing);
+                    reclaim();
+                }
+                return false;
+            }
+
+            std::atomic<Node *> &head = table->heads[indexFor(hash, table->count)];
+            head.store(pool_.create(key, value, hash, head.load(std::memory_order_relaxed)));
+            size_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool erase(const K &key, size_t hash) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Table *table = table_.load(std::memory_order_relaxed);
+            std::atomic<Node *> *link = findLink(table, key, hash);
+            Node *node = link->load(std::memory_order_relaxed);
+            if (!node) return false;
+
+            // The node keeps its next link, so a reader standing on it can
+            // still walk to the rest of the chain
+            link->store(node->next.load(std::memory_order_relaxed));
+            retiredNodes_.push_back(node);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            maybeShrink();
+            reclaim();
+            return true;
+        }
+
+        std::optional<V> get(const K &key, size_t hash) const {
+            const int parity = enterRead();
+            std::optional<V> result;
+            for (;;) {
+                const quint32 seq = resizeSeq_.load(std::memory_order_acquire);
+                const Table *table = table_.load(std::memory_order_acquire);
+                const Node *node = table->heads[indexFor(hash, table->count)].load(std::memory_order_acquire);
+                for (; node; node = node->next.load(std::memory_order_acquire)) {
+                    if (node->hash == hash && node->key == key) {
+                        result = node->value;
+                        break;
+                    }
+                }
+                // A hit is always genuine; a miss only counts if no resize
+                // moved nodes between chains while we walked
+                if (result || ((seq & 1) == 0 && resizeSeq_.load(std::memory_order_acquire) == seq)) break;
+            }
+            exitRead(parity);
+            return result;
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Table *old = table_.load(std::memory_order_relaxed);
+            table_.store(new Table(old->count));
+            for (int i = 0; i < old->count; ++i) {
+                for (Node *node = old->heads[i].load(std::memory_order_relaxed); node;
+                     node = node->next.load(std::memory_order_relaxed)) {
+                    retiredNodes_.push_back(node);
+                }
+            }
+            retiredTables_.push_back(old);
+            size_.store(0, std::memory_order_relaxed);
+            reclaim();
+        }
+
+        int size() const { return size_.load(std::memory_order_relaxed); }
+        int bucketCount() const { return table_.load(std::memory_order_acquire)->count; }
+
+    private:
+        struct Node {
+            Node(const K &k, const V &v, size_t h, Node *n) : key(k), value(v), hash(h), next(n) {}
+
+            const K key;
+            const V value;
+            const size_t hash;
+            std::atomic<Node *> next;
+        };
+
+        struct Table {
+            explicit Table(int bucketCount)
+                : count(bucketCount), heads(new std::atomic<Node *>[static_cast<size_t>(bucketCount)]) {
+                for (int i = 0; i < count; ++i) heads[i].store(nullptr, std::memory_order_relaxed);
+            }
+
+            const int count;
+            std::unique_ptr<std::atomic<Node *>[]> heads;
+        };
+
+        std::atomic<Table *> table_;
+        std::atomic<quint32> resizeSeq_{0};  // odd while a resize relinks nodes
+        std::atomic<int> size_{0};
+
+        // Readers register under the parity of epoch_; see reclaim()
+        std::atomic<quint32> epoch_{0};
+        mutable std::atomic<int> readers_[2] = {};
+
+        // Everything below is guarded by mutex_
+        std::mutex mutex_;
+        HashMapGrowthPolicy policy_;
+        HashMapNodePool<Node> pool_;
+        std::vector<Node *> retiredNodes_;   // unlinked, not yet in a grace period
+        std::vector<Table *> retiredTables_;
+        std::vector<Node *> graceNodes_;     // waiting for readers of graceParity_
+        std::vector<Table *> graceTables_;
+        int graceParity_ = -1;               // -1 when no grace period is open
+
+        static int indexFor(size_t hash, int bucketCount) {
+            return static_cast<int>(hash % static_cast<size_t>(bucketCount));
+        }
+
+        // The re-check makes sure the reader is counted under the parity
+        // that was current when it started reading
+        int enterRead() const {
+            for (;;) {
+                const quint32 epoch = epoch_.load();
+                const int parity = static_cast<int>(epoch & 1);
+                readers_[parity].fetch_add(1);
+                if (epoch_.load() == epoch) return parity;
+                readers_[parity].fetch_sub(1);
+            }
+        }
+
+        void exitRead(int parity) const { readers_[parity].fetch_sub(1, std::memory_order_release); }
+
+        // Link that points at the key's node, or the null link ending its chain
+        std::atomic<Node *> *findLink(Table *table, const K &key, size_t hash) {
+            std::atomic<Node *> *link = &table->heads[indexFor(hash, table->count)];
+            for (Node *node = link->load(std::memory_order_relaxed); node;
+                 node = link->load(std::memory_order_relaxed)) {
+                if (node->hash == hash && node->key == key) break;
+                link = &node->next;
+            }
+            return link;
+        }
+
+        // Two-phase reclamation. Retired memory waits for one grace period:
+        // flipping the epoch sends new readers to the other counter, and
+        // once the old parity's counter drains nobody can still reach what
+        // was retired before the flip. Only one grace period is open at a
+        // time, so a reader never spans two of them. Never blocks.
+        void reclaim() {
+            if (graceParity_ >= 0) {
+                if (readers_[graceParity_].load() != 0) return;
+                freeRetired(graceNodes_, graceTables_);
+                graceParity_ = -1;
+            }
+            if (retiredNodes_.empty() && retiredTables_.empty()) return;
+
+            graceNodes_.swap(retiredNodes_);
+            graceTables_.swap(retiredTables_);
+            graceParity_ = static_cast<int>(epoch_.fetch_add(1) & 1);
+            if (readers_[graceParity_].load() == 0) {
+                freeRetired(graceNodes_, graceTables_);
+                graceParity_ = -1;
+            }
+        }
+
+        void freeRetired(std::vector<Node *> &nodes, std::vector<Table *> &tables) {
+            for (Node *node : nodes) pool_.destroy(node);
+            for (Table *table : tables) delete table;
+            nodes.clear();
+            tables.clear();
+        }
+
+        void destroyChain(Node *node) {
+            while (node) {
+                Node *next = node->next.load(std::memory_order_relaxed);
+                pool_.destroy(node);
+                node = next;
+            }
+        }
+
+        // Relinks every node into a new bucket array. Readers still walking
+        // the old chains may be led astray, which the odd sequence number
+        // tells them to retry.
+        void resizeTo(int newCount) {
+            Table *old = table_.load(std::memory_order_relaxed);
+            Table *fresh = new Table(newCount);
+            resizeSeq_.fetch_add(1);
+            for (int i = 0; i < old->count; ++i) {
+                Node *node = old->heads[i].load(std::memory_order_relaxed);
+                while (node) {
+                    Node *next = node->next.load(std::memory_order_relaxed);
+                    std::atomic<Node *> &head = fresh->heads[indexFor(node->hash, newCount)];
+                    node->next.store(head.load(std::memory_order_relaxed));
+                    head.store(node, std::memory_order_relaxed);
+                    node = next;
+                }
+            }
+            table_.store(fresh);
+            resizeSeq_.fetch_add(1);
+            retiredTables_.push_back(old);
+            reclaim();
+        }
+
+        void maybeGrow() {
+            const int count = table_.load(std::memory_order_relaxed)->count;
+            if ((static_cast<float>(size()) + 1.0f) / static_cast<float>(count) > policy_.maxLoadFactor) {
+                resizeTo(policy_.grownCount(count));
+            }
+        }
+
+        void maybeShrink() {
+            const int count = table_.load(std::memory_order_relaxed)->count;
+            if (!policy_.shouldShrink(size(), count)) return;
+            const int newCount = policy_.shrunkCount(size());
+            if (newCount < count) resizeTo(newCount);
+        }
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    int shardBits_ = 0;
+
+    static size_t hashKey(const K &key) { return mixHash(KeyTraits::hash(key)); }
+
+    // The top shardBits_ bits pick the shard; buckets inside it use the
+    // low bits, so the two choices stay independent
+    int shardIndex(size_t hash) const {
+        if (shardBits_ == 0) return 0;
+        return static_cast<int>(hash >> (sizeof(size_t) * CHAR_BIT - static_cast<size_t>(shardBits_)));
+    }
+
+    Shard &shardFor(size_t hash) { return *shards_[static_cast<size_t>(shardIndex(hash))]; }
+    const Shard &shardFor(size_t hash) const { return *shards_[static_cast<size_t>(shardIndex(hash))]; }
+};
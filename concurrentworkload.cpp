@@ -0,0 +1,94 @@
+#include "concurrentworkload.h"
+#include <QThread>
+#include <random>
+
+namespace {
+
+// Ops between updates of the shared progress counter
+constexpr int ProgressBatch = 4096;
+
+} // namespace
+
+ConcurrentWorkload::ConcurrentWorkload() = default;
+
+ConcurrentWorkload::~ConcurrentWorkload() {
+    stop();
+}
+
+void ConcurrentWorkload::start(const Options &options) {
+    stop();
+
+    options_ = options;
+    options_.threads = std::max(1, options_.threads);
+    options_.keyRange = std::max(1, options_.keyRange);
+    map_ = std::make_unique<ConcurrentHashMap<int, int>>(options_.shards);
+    stopRequested_.store(false);
+    completedOps_.store(0);
+    finishedMs_.store(-1);
+    running_.store(options_.threads);
+    clock_.start();
+
+    for (int worker = 0; worker < options_.threads; ++worker) {
+        QThread *thread = QThread::create([this, worker] { runWorker(worker); });
+        threads_.push_back(thread);
+        thread->start();
+    }
+}
+
+void ConcurrentWorkload::stop() {
+    stopRequested_.store(true);
+    joinThreads();
+}
+
+void ConcurrentWorkload::joinThreads() {
+    for (QThread *thread : threads_) {
+        thread->wait();
+        delete thread;
+    }
+    threads_.clear();
+}
+
+qint64 ConcurrentWorkload::elapsedMs() const {
+    const qint64 finished = finishedMs_.load();
+    if (finished >= 0) return finished;
+    return clock_.isValid() ? clock_.elapsed() : 0;
+}
+
+int ConcurrentWorkload::shardCount() const {
+    return map_ ? map_->shardCount() : 0;
+}
+
+int ConcurrentWorkload::size() const {
+    return map_ ? map_->size() : 0;
+}
+
+QVector<int> ConcurrentWorkload::shardSizes() const {
+    return map_ ? map_->shardSizes() : QVector<int>();
+}
+
+void ConcurrentWorkload::runWorker(int worker) {
+    std::mt19937 rng(static_cast<unsigned>(worker) * 7919u + 1u);
+    std::uniform_int_distribution<int> keys(0, options_.keyRange - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    int pending = 0;
+    for (int op = 0; op < options_.opsPerThread && !stopRequested_.load(std::memory_order_relaxed); ++op) {
+        const int key = keys(rng);
+        const int roll = percent(rng);
+        if (roll < options_.readPercent) {
+            (void)map_->get(key);
+        } else if (roll % 10 == 0) {
+            map_->erase(key);
+        } else {
+            map_->put(key, op);
+        }
+        if (++pending == ProgressBatch) {
+            completedOps_.fetch_add(pending, std::memory_order_relaxed);
+            pending = 0;
+        }
+    }
+    completedOps_.fetch_add(pending, std::memory_order_relaxed);
+
+    // The last worker out stamps the run time
+    if (running_.fetch_sub(1) == 1) finishedMs_.store(clock_.elapsed());
+}
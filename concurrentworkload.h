@@ -0,0 +1,58 @@
+#pragma once
+
+#include "concurrenthashmap.h"
+#include <QElapsedTimer>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QThread;
+
+// Multi-threaded driver for ConcurrentHashMap<int, int>. Every worker runs
+// its own random mix of puts, gets and erases over one shared key range;
+// the visualizer polls the per-shard counters while the run is in flight.
+class ConcurrentWorkload {
+public:
+    struct Options {
+        int threads = 4;
+        int opsPerThread = 250000;
+        int keyRange = 1000000;
+        int readPercent = 50;   // the rest are writes, a tenth of them erases
+        int shards = 16;
+    };
+
+    ConcurrentWorkload();
+    ~ConcurrentWorkload();
+
+    ConcurrentWorkload(const ConcurrentWorkload &) = delete;
+    ConcurrentWorkload &operator=(const ConcurrentWorkload &) = delete;
+
+    // Starts a fresh map and workers; a run still in flight is stopped first
+    void start(const Options &options);
+    // Asks the workers to finish early and waits for them
+    void stop();
+
+    bool isRunning() const { return running_.load() > 0; }
+    const Options &options() const { return options_; }
+    qint64 completedOps() const { return completedOps_.load(std::memory_order_relaxed); }
+    // Wall time of the current run, or of the last one once it finished
+    qint64 elapsedMs() const;
+
+    int shardCount() const;
+    int size() const;
+    QVector<int> shardSizes() const;
+
+private:
+    Options options_;
+    std::unique_ptr<ConcurrentHashMap<int, int>> map_;
+    std::vector<QThread *> threads_;
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<int> running_{0};
+    std::atomic<qint64> completedOps_{0};
+    std::atomic<qint64> finishedMs_{-1};
+    QElapsedTimer clock_;
+
+    void runWorker(int worker);
+    void joinThreads();
+};
@@ -0,0 +1,509 @@
+#pragma once
+
+#include "hashmapcore.h"
+
+// Open-addressing hash map using cuckoo hashing over two tables plus a small
+// stash. Every key has exactly one candidate slot in each table, so a lookup
+// reads at most two slots (and the stash, which is usually empty) no matter
+// how full the table is. An insert that finds both candidates taken evicts
+// ("kicks") the resident of one of them, which moves to its own other slot,
+// and so on; a chain that runs too long parks the homeless entry in the
+// stash, and a full stash forces a rehash into larger tables. Keys with equal
+// full hashes share both candidates at every size, so once they fill both
+// the stash grows past StashSize instead.
+//
+// Slot layout: [0, T) is the first table, [T, 2T) the second and the
+// remaining slots (StashSize, or more after an overflow) are the stash, so
+// every entry can be drawn and visited by slot index like the other open
+// addressing backends.
+template <typename K, typename V, typename Tracer = StepTrace>
+class CuckooHashMap : private HashMapStepRecorder<K, V, Tracer> {
+    using Recorder = HashMapStepRecorder<K, V, Tracer>;
+    using typename Recorder::KeyTraits;
+    using typename Recorder::ValueTraits;
+    using Recorder::addStep;
+    using Recorder::addEntryStep;
+    using Recorder::addValueStep;
+    using Recorder::addUpdateStep;
+    using Recorder::addGrowStep;
+    using Recorder::addHashSteps;
+    using Recorder::addCompareStep;
+    using Recorder::runBatch;
+    using Recorder::muteSteps;
+    using Recorder::markDirty;
+    using Recorder::markAllDirty;
+    using Recorder::keyHash;
+    using Recorder::hashStrategy_;
+
+public:
+    using KeyType = K;
+    using ValueType = V;
+    using Recorder::takeDirtyBuckets;
+
+    // Growth always rebuilds both tables in one step
+    static constexpr bool supportsIncrementalRehash = false;
+    static constexpr bool tracksKickChains = true;
+
+    // Entries parked after a failed kick chain
+    static constexpr int StashSize = 4;
+    // Displacements tried before an entry goes to the stash
+    static constexpr int MaxKicks = 32;
+    // Failed rebuilds that grow the tables before one lets the stash grow
+    static constexpr int MaxGrowthRounds = 4;
+
+    explicit CuckooHashMap(int initialBucketCount = 16, const HashMapGrowthPolicy &policy = {},
+                           StepLog *steps = nullptr)
+        : Recorder(steps),
+        policy_(sanitize(policy)) {
+        resize(tableSizeFor(initialBucketCount));
+    }
+
+    // Insert without overwriting; returns true if a new key was added
+    bool insert(const K &key, const V &value) {
+        maybeGrow();
+        return emplaceOrAssign(key, value, keyHash(key), /*assignIfExists=*/false);
+    }
+
+    // Insert or overwrite; returns true if a new key was added
+    bool put(const K &key, const V &value) {
+        maybeGrow();
+        return emplaceOrAssign(key, value, keyHash(key), /*assignIfExists=*/true);
+    }
+
+    // Bulk insert (or put, with assignIfExists) of count pairs. The tables
+    // are presized once and per-key steps are not recorded. Returns the
+    // number of new keys.
+    int insertBatch(const K *keys, const V *values, int count, bool assignIfExists) {
+        if (count <= 0) return 0;
+        int added = 0;
+        muteSteps(true);
+        reserve(numElements_ + count);
+        runBatch(keys, count, [this](const K &key) { return keyHash(key); },
+                 [this](size_t hash) { prefetchCandidates(hash); },
+                 [&](int i, size_t hash) {
+                     maybeGrow();
+                     if (emplaceOrAssign(keys[i], values[i], hash, assignIfExists)) ++added;
+                 });
+        muteSteps(false);
+        return added;
+    }
+
+    // Bulk lookup: out[i] receives the value stored for keys[i], or nullptr
+    void findBatch(const K *keys, int count, const V **out) {
+        if (count <= 0) return;
+        muteSteps(true);
+        runBatch(keys, count, [this](const K &key) { return keyHash(key); },
+                 [this](size_t hash) { prefetchCandidates(hash); },
+                 [&](int i, size_t hash) { out[i] = findHashed(keys[i], hash); });
+        muteSteps(false);
+    }
+
+    // Returns a pointer to the stored value, or nullptr if absent. Q is K or
+    // any type KeyTraits can hash and K compares equal to (QStringView).
+    template <typename Q>
+    const V *find(const Q &key) {
+        return findHashed(key, keyHash(key));
+    }
+
+    template <typename Q>
+    bool erase(const Q &key) {
+        const size_t hash = keyHash(key);
+        const int first = slotFor(hash, 0);
+        addHashSteps(key, hash, tableSize_, first, policy_.reducer);
+        addStep(HashMapTrace::Visit, first, 0, HashMapTrace::SlotUnit);
+
+        const int pos = locate(key, hash);
+        if (pos < 0) {
+            addStep(HashMapTrace::NotInCandidates, -1, 0, HashMapTrace::ForErase);
+            return false;
+        }
+
+        slots_[static_cast<size_t>(pos)] = Slot();
+        markDirty(pos);
+        if (pos >= stashBegin()) {
+            // Keep the stash packed so probes stop at stashCount_
+            const int last = stashBegin() + stashCount_ - 1;
+            if (pos != last) {
+                Slot &from = slots_[static_cast<size_t>(last)];
+                addEntryStep(HashMapTrace::ShiftBack, from.key, from.value, last, 0, static_cast<quint64>(pos));
+                slots_[static_cast<size_t>(pos)] = std::move(from);
+                from = Slot();
+                markDirty(last);
+            }
+            --stashCount_;
+        }
+        --numElements_;
+        addStep(HashMapTrace::Erased, bucketCount(), numElements_, HashMapTrace::SlotUnit);
+        maybeShrink();
+        return true;
+    }
+
+    void clear() {
+        std::fill(slots_.begin(), slots_.end(), Slot());
+        numElements_ = 0;
+        stashCount_ = 0;
+        maxKickChain_ = 0;
+        markAllDirty();
+    }
+
+    // newBucketCount is the table capacity (both tables, without the stash).
+    // If the entries cannot all be placed, the tables grow again until they are.
+    void rehash(int newBucketCount) {
+        rehashWith(newBucketCount, takeEntries());
+    }
+
+    // Grows the tables now so that n entries fit under the max load factor
+    void reserve(int n) {
+        const int needed = policy_.bucketsFor(n);
+        if (needed > capacity()) rehash(needed);
+    }
+
+    // A new reducer moves every candidate slot, so the tables are rebuilt
+    void setGrowthPolicy(const HashMapGrowthPolicy &policy) {
+        const bool reindex = policy.reducer != policy_.reducer;
+        policy_ = sanitize(policy);
+        if (reindex) rehash(capacity());
+    }
+
+    int size() const { return numElements_; }
+    int bucketCount() const { return static_cast<int>(slots_.size()); }
+
+    // Load over the two tables; the stash is overflow, not capacity
+    float loadFactor() const {
+        return static_cast<float>(numElements_) / static_cast<float>(std::max(1, capacity()));
+    }
+
+    size_t hashOf(const K &key) const { return keyHash(key); }
+
+    // First-table candidate for a slot array of bucketCount slots
+    int indexFor(const K &key, int bucketCount) const {
+        const int stash = bucketCount == this->bucketCount() ? stashSlots() : StashSize;
+        return reduceHash(keyHash(key), std::max(1, (bucketCount - stash) / 2), policy_.reducer);
+    }
+
+    // Switching the hash function moves every candidate slot, so stored
+    // hashes are recomputed and the tables rebuilt at the current size
+    void setHashStrategy(const HashStrategy &strategy) {
+        if (strategy == hashStrategy_) return;
+        hashStrategy_ = strategy;
+        for (Slot &slot : slots_) {
+            if (slot.occupied) slot.hash = keyHash(slot.key);
+        }
+        if (numElements_ > 0) rehash(capacity());
+    }
+
+    // Entries per first-table candidate slot
+    QVector<int> homeBucketCounts() const {
+        QVector<int> counts(tableSize_, 0);
+        for (const Slot &slot : slots_) {
+            if (slot.occupied) ++counts[slotFor(slot.hash, 0)];
+        }
+        return counts;
+    }
+
+    // 1/0 occupancy per slot, stash included
+    QVector<int> bucketSizes() const {
+        QVector<int> sizes;
+        sizes.reserve(bucketCount());
+        for (const Slot &slot : slots_) {
+            sizes.push_back(slot.occupied ? 1 : 0);
+        }
+        return sizes;
+    }
+
+    QVector<int> chainLengthHistogram() const { return HashMapChainStats::histogramOf(bucketSizes()); }
+    int maxChainLength() const { return chainLengthHistogram().size() - 1; }
+
+    // Longest displacement chain since the tables were last built
+    int maxKickChain() const { return maxKickChain_; }
+    int stashCount() const { return stashCount_; }
+
+    // Visit the entry held in one slot (at most one); returns 1 if visited
+    template <typename Fn>
+    int forEachInBucket(int index, Fn &&fn, int maxEntries = -1) const {
+        const Slot &slot = slots_[static_cast<size_t>(index)];
+        if (!slot.occupied || maxEntries == 0) return 0;
+        fn(slot.key, slot.value);
+        return 1;
+    }
+
+    int bucketEntryCount(int index) const { return slots_[static_cast<size_t>(index)].occupied ? 1 : 0; }
+
+private:
+    struct Slot {
+        K key{};
+        V value{};
+        size_t hash = 0;  // full key hash; both candidates derive from it
+        bool occupied = false;
+    };
+
+    HashMapGrowthPolicy policy_;
+    std::vector<Slot> slots_;
+    int tableSize_ = 0;   // slots per table
+    int numElements_ = 0;
+    int stashCount_ = 0;  // stash slots in use, packed from stashBegin()
+    int maxKickChain_ = 0;
+
+    // Two single-slot tables stop accepting inserts reliably near 50% load
+    static HashMapGrowthPolicy sanitize(const HashMapGrowthPolicy &policy) {
+        return policy.sanitized(0.45f);
+    }
+
+    int capacity() const { return 2 * tableSize_; }
+    int stashBegin() const { return capacity(); }
+    int stashSlots() const { return static_cast<int>(slots_.size()) - capacity(); }
+
+    // Per-table size for a capacity spread over both tables
+    int tableSizeFor(int capacity) const {
+        return policy_.roundedCount((std::max(capacity, 2) + 1) / 2);
+    }
+
+    void resize(int tableSize) {
+        tableSize_ = tableSize;
+        slots_.assign(static_cast<size_t>(2 * tableSize + StashSize), Slot());
+        stashCount_ = 0;
+        maxKickChain_ = 0;
+    }
+
+    // The second table indexes a remixed hash, so keys that collide in one
+    // table are spread independently in the other
+    static size_t alternateHash(size_t hash) {
+        const quint64 h = (static_cast<quint64>(hash) ^ 0xD6E8FEB86659FD93ull) * 0xFF51AFD7ED558CCDull;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+
+    // Candidate slot of hash in table 0 or 1
+    int slotFor(size_t hash, int table) const {
+        return table == 0 ? reduceHash(hash, tableSize_, policy_.reducer)
+                          : tableSize_ + reduceHash(alternateHash(hash), tableSize_, policy_.reducer);
+    }
+
+    // The candidate of hash in the table pos does not belong to
+    int otherSlot(size_t hash, int pos) const {
+        return slotFor(hash, pos < tableSize_ ? 1 : 0);
+    }
+
+    // Both candidates are independent cache lines; fetch them together
+    void prefetchCandidates(size_t hash) const {
+        prefetchForRead(&slots_[static_cast<size_t>(slotFor(hash, 0))]);
+        prefetchForRead(&slots_[static_cast<size_t>(slotFor(hash, 1))]);
+    }
+
+    template <typename Q>
+    const V *findHashed(const Q &key, size_t hash) {
+        const int first = slotFor(hash, 0);
+        addHashSteps(key, hash, tableSize_, first, policy_.reducer);
+        addStep(HashMapTrace::Visit, first, 0, HashMapTrace::SlotUnit | HashMapTrace::Target);
+
+        const int pos = locate(key, hash);
+        if (pos < 0) {
+            addStep(HashMapTrace::NotInCandidates);
+            return nullptr;
+        }
+        addValueStep(HashMapTrace::Found, slots_[static_cast<size_t>(pos)].value);
+        return &slots_[static_cast<size_t>(pos)].value;
+    }
+
+    template <typename Q>
+    bool matches(int pos, const Q &key, size_t hash) {
+        const Slot &slot = slots_[static_cast<size_t>(pos)];
+        if (!slot.occupied) return false;
+        const bool hashMatch = slot.hash == hash;
+        const bool match = hashMatch && slot.key == key;
+        addCompareStep(slot.key, match, hashMatch);
+        return match;
+    }
+
+    // Slot holding key, or -1: its two candidates, then the stash
+    template <typename Q>
+    int locate(const Q &key, size_t hash) {
+        const int first = slotFor(hash, 0);
+        if (matches(first, key, hash)) return first;
+
+        const int second = slotFor(hash, 1);
+        addStep(HashMapTrace::ProbeAlternate, second);
+        if (matches(second, key, hash)) return second;
+
+        if (stashCount_ == 0) return -1;
+        addStep(HashMapTrace::ProbeStash, stashBegin(), stashCount_);
+        for (int pos = stashBegin(); pos < stashBegin() + stashCount_; ++pos) {
+            if (matches(pos, key, hash)) return pos;
+        }
+        return -1;
+    }
+
+    // Both candidates of hash hold entries with that same full hash. No
+    // table size separates them, so a further one can only go to the stash.
+    bool candidatesShareHash(size_t hash) const {
+        for (int table = 0; table < 2; ++table) {
+            const Slot &slot = slots_[static_cast<size_t>(slotFor(hash, table))];
+            if (!slot.occupied || slot.hash != hash) return false;
+        }
+        return true;
+    }
+
+    // Places carry, kicking residents along their alternate slots. Returns
+    // the slot the entry passed in ended up in; -1 if the chain ran out and
+    // the stash is full, in which case carry holds the entry left without a
+    // slot (not necessarily the one passed in). A full stash grows by a slot
+    // when growStash is set or the homeless entry's candidates share its hash.
+    int place(Slot &carry, bool growStash = false) {
+        carry.occupied = true;
+        int pos = slotFor(carry.hash, 0);
+        if (slots_[static_cast<size_t>(pos)].occupied) {
+            const int second = slotFor(carry.hash, 1);
+            if (!slots_[static_cast<size_t>(second)].occupied) pos = second;
+        }
+
+        // Where the entry passed in sits; -1 while it is the one in carry.
+        // A chain can cycle back and kick it out again.
+        int placedAt = -1;
+        for (int kicks = 0;; ++kicks) {
+            Slot &slot = slots_[static_cast<size_t>(pos)];
+            if (!slot.occupied) {
+                slot = std::move(carry);
+                markDirty(pos);
+                maxKickChain_ = std::max(maxKickChain_, kicks);
+                if (kicks > 0) addStep(HashMapTrace::KickSettled, pos, kicks);
+                return placedAt < 0 ? pos : placedAt;
+            }
+            if (kicks == MaxKicks) break;
+
+            std::swap(slot, carry);
+            markDirty(pos);
+            if (placedAt < 0) {
+                placedAt = pos;
+            } else if (pos == placedAt) {
+                placedAt = -1;
+            }
+            const int next = otherSlot(carry.hash, pos);
+            addEntryStep(HashMapTrace::Kick, carry.key, carry.value, pos, 0, static_cast<quint64>(next));
+            pos = next;
+        }
+
+        maxKickChain_ = std::max(maxKickChain_, MaxKicks);
+        if (stashCount_ == stashSlots()) {
+            if (!growStash && !candidatesShareHash(carry.hash)) return -1;
+            slots_.emplace_back();
+            markAllDirty();
+        }
+        const int stashed = stashBegin() + stashCount_++;
+        slots_[static_cast<size_t>(stashed)] = std::move(carry);
+        markDirty(stashed);
+        addStep(HashMapTrace::Stashed, stashed, stashCount_);
+        return placedAt < 0 ? stashed : placedAt;
+    }
+
+    std::vector<Slot> takeEntries() {
+        std::vector<Slot> entries;
+        entries.reserve(static_cast<size_t>(numElements_) + 1);
+        for (Slot &slot : slots_) {
+            if (slot.occupied) entries.push_back(std::move(slot));
+        }
+        return entries;
+    }
+
+    void rehashWith(int newBucketCount, std::vector<Slot> pending) {
+        int tableSize = tableSizeFor(std::max(newBucketCount, static_cast<int>(pending.size()) + 1));
+        for (int round = 0;; ++round) {
+            addStep(HashMapTrace::Rehash, 2 * tableSize + StashSize, 0, HashMapTrace::SlotUnit);
+            markAllDirty();
+            // The last round cannot fail, so the tables stop doubling even if
+            // some keys are never separated
+            if (rebuild(tableSize, pending, round == MaxGrowthRounds)) return;
+            addStep(HashMapTrace::KickLimit, -1, MaxKicks);
+            tableSize = tableSizeFor(policy_.grownCount(2 * tableSize));
+        }
+    }
+
+    // Fills fresh tables of tableSize slots from pending. On failure every
+    // entry, placed or not, is handed back in pending for a larger retry;
+    // with growStash it always succeeds.
+    bool rebuild(int tableSize, std::vector<Slot> &pending, bool growStash) {
+        resize(tableSize);
+        for (size_t i = 0; i < pending.size(); ++i) {
+            Slot carry = std::move(pending[i]);
+            const int placedAt = place(carry, growStash);
+            if (placedAt < 0) {
+                std::vector<Slot> retry;
+                retry.reserve(pending.size());
+                for (Slot &slot : slots_) {
+                    if (slot.occupied) retry.push_back(std::move(slot));
+                }
+                retry.push_back(std::move(carry));
+                for (size_t j = i + 1; j < pending.size(); ++j) retry.push_back(std::move(pending[j]));
+                pending.swap(retry);
+                return false;
+            }
+            const Slot &moved = slots_[static_cast<size_t>(placedAt)];
+            addEntryStep(HashMapTrace::Move, moved.key, moved.value, placedAt, HashMapTrace::SlotUnit);
+        }
+        numElements_ = static_cast<int>(pending.size());
+        return true;
+    }
+
+    void maybeGrow() {
+        const float projected = (static_cast<float>(numElements_) + 1.0f) / static_cast<float>(std::max(1, capacity()));
+        if (projected > policy_.maxLoadFactor) {
+            const int newCount = policy_.grownCount(capacity());
+            addGrowStep(projected, policy_.maxLoadFactor, newCount, HashMapTrace::SlotUnit);
+            rehash(newCount);
+        }
+    }
+
+    void maybeShrink() {
+        if (!policy_.shouldShrink(numElements_, capacity())) return;
+
+        const int newCount = policy_.shrunkCount(numElements_);
+        if (tableSizeFor(newCount) >= tableSize_) return;
+        addGrowStep(loadFactor(), policy_.minLoadFactor, newCount, HashMapTrace::SlotUnit | HashMapTrace::Shrink);
+        rehash(newCount);
+    }
+
+    bool emplaceOrAssign(const K &key, const V &value, size_t hash, bool assignIfExists) {
+        const int first = slotFor(hash, 0);
+        addHashSteps(key, hash, tableSize_, first, policy_.reducer);
+        addStep(HashMapTrace::Visit, first, 0, HashMapTrace::SlotUnit);
+
+        const int pos = locate(key, hash);
+        if (pos >= 0) {
+            Slot &slot = slots_[static_cast<size_t>(pos)];
+            if (assignIfExists) {
+                addUpdateStep(slot.value, value);
+                slot.value = value;
+                markDirty(pos);
+            } else {
+                addStep(HashMapTrace::Duplicate);
+            }
+            return false; // not a new insertion
+        }
+
+        Slot carry{key, value, hash, true};
+        int placedAt = place(carry);
+        ++numElements_;
+        if (placedAt < 0) {
+            // Chain and stash exhausted: the homeless entry joins the rebuild
+            addStep(HashMapTrace::KickLimit, -1, MaxKicks);
+            std::vector<Slot> pending = takeEntries();
+            pending.push_back(std::move(carry));
+            rehashWith(policy_.grownCount(capacity()), std::move(pending));
+            placedAt = locateQuiet(key, hash);
+        }
+        addStep(HashMapTrace::PlaceInTable, placedAt, placedAt < tableSize_ ? 0 : (placedAt < stashBegin() ? 1 : 2));
+        addStep(HashMapTrace::NewSize, bucketCount(), numElements_);
+        return true;
+    }
+
+    // locate() without compare steps, after a rebuild moved the new key
+    int locateQuiet(const K &key, size_t hash) const {
+        for (int table = 0; table < 2; ++table) {
+            const Slot &slot = slots_[static_cast<size_t>(slotFor(hash, table))];
+            if (slot.occupied && slot.hash == hash && slot.key == key) return slotFor(hash, table);
+        }
+        for (int pos = stashBegin(); pos < stashBegin() + stashCount_; ++pos) {
+            const Slot &slot = slots_[static_cast<size_t>(pos)];
+            if (slot.hash == hash && slot.key == key) return pos;
+        }
+        return -1;
+    }
+};
@@ -1,4 +1,5 @@
 #include "graphvisualization.h"
+#include <QScrollBar>
 
 // Dedicated canvas widget for drawing the graph
 class GraphVisualization::GraphCanvas : public QWidget
@@ -480,8 +481,23 @@ void GraphVisualization::setupStepTrace()
     )");
 
     // Steps tab - using StyleManager for beautiful scroll bars
-    stepsList = new QListWidget();
+    stepsList = new QListView();
     StyleManager::instance().applyStepTraceStyle(stepsList);
+    stepsList->setUniformItemSizes(true);
+    stepsModel = new StepListModel(&stepHistory, this);
+    stepsModel->setCategoryColor(StepCategory::Success, QColor("#28a745"));
+    stepsModel->setCategoryColor(StepCategory::Failure, QColor("#dc3545"));
+    stepsModel->setCategoryColor(StepCategory::Search, QColor("#007bff"));
+    stepsModel->setCategoryColor(StepCategory::Insert, QColor("#6f42c1"));
+    stepsModel->setCategoryColor(StepCategory::Delete, QColor("#fd7e14"));
+    stepsModel->setCategoryColor(StepCategory::Calculate, QColor("#20c997"));
+    stepsModel->setCategoryColor(StepCategory::Rotate, QColor("#e83e8c"));
+    stepsModel->setCategoryColor(StepCategory::Plain, QColor("#495057"));
+    stepsModel->setCategoryColor(StepCategory::Separator, QColor("#7b4fff"));
+    QFont separatorFont;
+    separatorFont.setBold(true);
+    stepsModel->setSeparatorFont(separatorFont);
+    stepsList->setModel(stepsModel);
 
     // Algorithm tab - using StyleManager for beautiful scroll bars
     algorithmList = new QListWidget();
@@ -556,53 +572,38 @@ void GraphVisualization::setupTraversalControls()
 
 void GraphVisualization::addStepToHistory(const QString &step)
 {
-    stepHistory.append(step);
+    stepHistory.appendText(step);
     updateStepTrace();
 }
 
 void GraphVisualization::addOperationSeparator()
 {
-    stepHistory.append("────────────────────");
+    stepHistory.appendSeparator();
     updateStepTrace();
 }
 
 void GraphVisualization::updateStepTrace()
 {
-    stepsList->clear();
-    
-    for (const QString &step : stepHistory) {
-        QListWidgetItem *item = new QListWidgetItem(step);
-        
-        if (step == "────────────────────") {
-            item->setTextAlignment(Qt::AlignCenter);
-            item->setForeground(QColor("#7b4fff"));
-            QFont separatorFont = item->font();
-            separatorFont.setBold(true);
-            item->setFont(separatorFont);
-        } else if (step.contains("✅") || step.contains("🎯")) {
-            item->setForeground(QColor("#28a745"));
-        } else if (step.contains("❌") || step.contains("⚠️")) {
-            item->setForeground(QColor("#dc3545"));
-        } else if (step.contains("🔍") || step.contains("👀")) {
-            item->setForeground(QColor("#007bff"));
-        } else if (step.contains("➕") || step.contains("🆕")) {
-            item->setForeground(QColor("#6f42c1"));
-        } else if (step.contains("🗑️") || step.contains("❌")) {
-            item->setForeground(QColor("#fd7e14"));
-        } else if (step.contains("🧮") || step.contains("⚡")) {
-            item->setForeground(QColor("#20c997"));
-        } else if (step.contains("🔄") || step.contains("↗️") || step.contains("↙️")) {
-            item->setForeground(QColor("#e83e8c"));
-        } else {
-            item->setForeground(QColor("#495057"));
-        }
-        
-        stepsList->addItem(item);
-    }
+    // Only the rows appended since the last call reach the view
+    stepsModel->sync();
     
     stepsList->scrollToBottom();
 }
 
+StepCategory GraphVisualization::categorizeStep(const StepEvent &event, const StepLog &log)
+{
+    // Classified once, when the step is recorded
+    const QString step = log.operand(event.key).toString();
+    if (step.contains("✅") || step.contains("🎯")) return StepCategory::Success;
+    if (step.contains("❌") || step.contains("⚠️")) return StepCategory::Failure;
+    if (step.contains("🔍") || step.contains("👀")) return StepCategory::Search;
+    if (step.contains("➕") || step.contains("🆕")) return StepCategory::Insert;
+    if (step.contains("🗑️")) return StepCategory::Delete;
+    if (step.contains("🧮") || step.contains("⚡")) return StepCategory::Calculate;
+    if (step.contains("🔄") || step.contains("↗️") || step.contains("↙️")) return StepCategory::Rotate;
+    return StepCategory::Plain;
+}
+
 void GraphVisualization::showAlgorithm(const QString &operation)
 {
     currentOperation = operation;
@@ -1103,7 +1104,6 @@ void GraphVisualization::onClearClicked()
     traversalIndex = 0;
     animTimer->stop();
     stepHistory.clear();
-    stepsList->clear();
     refreshCombos();
     statusLabel->setText("Graph cleared! Add a vertex to begin.");
     addStepToHistory("🗑️ Entire graph cleared");
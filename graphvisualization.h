@@ -32,6 +32,8 @@
 #include "stylemanager.h"
 #include "widgetmanager.h"
 #include "uiutils.h"
+#include "steplog.h"
+#include "steplistmodel.h"
 
 struct GraphNode {
     int id;
@@ -90,6 +92,7 @@ private:
     void addStepToHistory(const QString &step);
     void addOperationSeparator();
     void updateStepTrace();
+    static StepCategory categorizeStep(const StepEvent &event, const StepLog &log);
     void showAlgorithm(const QString &operation);
 
     // Animation state
@@ -130,7 +133,8 @@ private:
     // Right panel components - Chat box
     QGroupBox *traceGroup;
     QTabWidget *traceTabWidget;
-    QListWidget *stepsList;
+    QListView *stepsList;
+    StepListModel *stepsModel;
     QListWidget *algorithmList;
     
     // Right panel components - Traversal controls
@@ -143,7 +147,7 @@ private:
     QVector<GraphNode> nodes;
     QHash<int, QSet<int>> adjacency; // undirected, unweighted
     int nextId;
-    QVector<QString> stepHistory;
+    StepLog stepHistory{nullptr, &GraphVisualization::categorizeStep};
     QString currentOperation;
 
     // Drawing constants
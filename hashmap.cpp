@@ -1,11 +1,331 @@
 #include "hashmap.h"
+#include "hashmapcore.h"
+#include "hashmapsnapshot.h"
+#include "cuckoohashmap.h"
+#include "robinhoodhashmap.h"
+#include "swisshashmap.h"
+#include <type_traits>
+
+// Type-erased interface over the typed engines. Each call converts its QVariant
+// arguments exactly once; the typed map then hashes and compares natively.
+class HashMapEngine {
+public:
+    virtual ~HashMapEngine() = default;
+
+    virtual bool insert(const QVariant &key, const QVariant &value) = 0;
+    virtual bool put(const QVariant &key, const QVariant &value) = 0;
+    virtual std::optional<QVariant> get(const QVariant &key) = 0;
+    virtual bool erase(const QVariant &key) = 0;
+    // String-key lookups without building a QVariant or QString
+    virtual std::optional<QVariant> get(QStringView key) = 0;
+    virtual bool erase(QStringView key) = 0;
+    // Keys and values arrive type-checked; returns the number of new keys
+    virtual int insertBatch(const QVariant *keys, const QVariant *values, int count, bool assignIfExists) = 0;
+    virtual QVector<std::optional<QVariant>> getBatch(const QVariant *keys, int count) = 0;
+    virtual void clear() = 0;
+    virtual void rehash(int newBucketCount) = 0;
+    virtual void setIncrementalRehash(int bucketsPerStep) = 0;
+    virtual void setGrowthPolicy(const HashMapGrowthPolicy &policy) = 0;
+    virtual void reserve(int n) = 0;
+    virtual bool isRehashing() const = 0;
+    virtual void setHashStrategy(const HashStrategy &strategy) = 0;
+
+    virtual int size() const = 0;
+    virtual int bucketCount() const = 0;
+    virtual float loadFactor() const = 0;
+    virtual int indexFor(const QVariant &key, int bucketCount) const = 0;
+    virtual size_t hashOf(const QVariant &key) const = 0;
+    virtual QVector<int> bucketSizes() const = 0;
+    virtual QVector<int> homeBucketCounts() const = 0;
+    virtual QVector<int> chainLengthHistogram() const = 0;
+    virtual int maxChainLength() const = 0;
+    virtual int maxKickChain() const = 0;
+    virtual int forEachInBucket(int index, const HashMap::EntryVisitor &visit, int maxEntries) const = 0;
+    virtual int bucketEntryCount(int index) const = 0;
+    virtual HashMapDirtySet takeDirtyBuckets() = 0;
+    virtual bool writeSnapshot(const QString &path, const HashStrategy &strategy, QString *error) const = 0;
+    virtual int loadSnapshot(const HashMapSnapshot &snapshot) = 0;
+};
+
+namespace {
+
+template <typename T>
+std::vector<T> fromVariants(const QVariant *variants, int count) {
+    std::vector<T> converted;
+    converted.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        converted.push_back(HashMapTraits<T>::fromVariant(variants[i]));
+    }
+    return converted;
+}
+
+template <typename Map>
+class TypedHashMapEngine final : public HashMapEngine {
+    using K = typename Map::KeyType;
+    using V = typename Map::ValueType;
+
+public:
+    TypedHashMapEngine(int bucketCount, const HashMapGrowthPolicy &policy, StepLog *steps)
+        : map_(bucketCount, policy, steps) {}
+
+    bool insert(const QVariant &key, const QVariant &value) override {
+        return map_.insert(HashMapTraits<K>::fromVariant(key), HashMapTraits<V>::fromVariant(value));
+    }
+
+    bool put(const QVariant &key, const QVariant &value) override {
+        return map_.put(HashMapTraits<K>::fromVariant(key), HashMapTraits<V>::fromVariant(value));
+    }
+
+    std::optional<QVariant> get(const QVariant &key) override {
+        const V *value = map_.find(HashMapTraits<K>::fromVariant(key));
+        if (!value) return std::nullopt;
+        return QVariant::fromValue(*value);
+    }
+
+    bool erase(const QVariant &key) override {
+        return map_.erase(HashMapTraits<K>::fromVariant(key));
+    }
+
+    std::optional<QVariant> get(QStringView key) override {
+        const V *value = nullptr;
+        if constexpr (std::is_same_v<K, QString>) {
+            value = map_.find(key);
+        } else {
+            value = map_.find(HashMapTraits<K>::fromVariant(QVariant(key.toString())));
+        }
+        if (!value) return std::nullopt;
+        return QVariant::fromValue(*value);
+    }
+
+    bool erase(QStringView key) override {
+        if constexpr (std::is_same_v<K, QString>) {
+            return map_.erase(key);
+        } else {
+            return map_.erase(HashMapTraits<K>::fromVariant(QVariant(key.toString())));
+        }
+    }
+
+    int insertBatch(const QVariant *keys, const QVariant *values, int count, bool assignIfExists) override {
+        const std::vector<K> typedKeys = fromVariants<K>(keys, count);
+        const std::vector<V> typedValues = fromVariants<V>(values, count);
+        return map_.insertBatch(typedKeys.data(), typedValues.data(), count, assignIfExists);
+    }
+
+    QVector<std::optional<QVariant>> getBatch(const QVariant *keys, int count) override {
+        const std::vector<K> typedKeys = fromVariants<K>(keys, count);
+        std::vector<const V *> found(static_cast<size_t>(count), nullptr);
+        map_.findBatch(typedKeys.data(), count, found.data());
+
+        QVector<std::optional<QVariant>> results;
+        results.reserve(count);
+        for (const V *value : found) {
+            results.push_back(value ? std::optional<QVariant>(QVariant::fromValue(*value)) : std::nullopt);
+        }
+        return results;
+    }
+
+    void clear() override { map_.clear(); }
+    void rehash(int newBucketCount) override { map_.rehash(newBucketCount); }
+
+    void setIncrementalRehash(int bucketsPerStep) override {
+        if constexpr (Map::supportsIncrementalRehash) map_.setIncrementalRehash(bucketsPerStep);
+    }
 
-HashMap::HashMap(int initialBucketCount, float maxLoadFactor)
-    : buckets_(static_cast<size_t>(std::max(1, initialBucketCount))),
-    numElements_(0),
-    maxLoadFactor_(maxLoadFactor),
-    hasRehashed_(false) {
-    stepHistory_.clear();
+    void setGrowthPolicy(const HashMapGrowthPolicy &policy) override { map_.setGrowthPolicy(policy); }
+    void reserve(int n) override { map_.reserve(n); }
+
+    bool isRehashing() const override {
+        if constexpr (Map::supportsIncrementalRehash) return map_.isRehashing();
+        return false;
+    }
+
+    void setHashStrategy(const HashStrategy &strategy) override { map_.setHashStrategy(strategy); }
+
+    int size() const override { return map_.size(); }
+    int bucketCount() const override { return map_.bucketCount(); }
+    float loadFactor() const override { return map_.loadFactor(); }
+
+    int indexFor(const QVariant &key, int bucketCount) const override {
+        return map_.indexFor(HashMapTraits<K>::fromVariant(key), std::max(1, bucketCount));
+    }
+
+    size_t hashOf(const QVariant &key) const override {
+        return map_.hashOf(HashMapTraits<K>::fromVariant(key));
+    }
+
+    QVector<int> bucketSizes() const override { return map_.bucketSizes(); }
+    QVector<int> homeBucketCounts() const override { return map_.homeBucketCounts(); }
+    QVector<int> chainLengthHistogram() const override { return map_.chainLengthHistogram(); }
+    int maxChainLength() const override { return map_.maxChainLength(); }
+
+    int maxKickChain() const override {
+        if constexpr (Map::tracksKickChains) return map_.maxKickChain();
+        return 0;
+    }
+
+    // Only the visited entries are converted to QVariant
+    int forEachInBucket(int index, const HashMap::EntryVisitor &visit, int maxEntries) const override {
+        return map_.forEachInBucket(index, [&visit](const K &key, const V &value) {
+            visit(QVariant::fromValue(key), QVariant::fromValue(value));
+        }, maxEntries);
+    }
+
+    int bucketEntryCount(int index) const override { return map_.bucketEntryCount(index); }
+    HashMapDirtySet takeDirtyBuckets() override { return map_.takeDirtyBuckets(); }
+
+    // Entries are referenced in place while the file is written
+    bool writeSnapshot(const QString &path, const HashStrategy &strategy, QString *error) const override {
+        HashMapSnapshotWriter<K, V> writer(strategy);
+        writer.reserve(map_.size());
+        for (int i = 0; i < map_.bucketCount(); ++i) {
+            map_.forEachInBucket(i, [&writer](const K &key, const V &value) { writer.add(key, value); });
+        }
+        return writer.write(path, error);
+    }
+
+    // Rows go straight from the mapped columns into typed arrays for the
+    // batch insert; no QVariant is built
+    int loadSnapshot(const HashMapSnapshot &snapshot) override {
+        const int count = snapshot.size();
+        std::vector<K> keys;
+        std::vector<V> values;
+        keys.reserve(static_cast<size_t>(count));
+        values.reserve(static_cast<size_t>(count));
+        for (int row = 0; row < count; ++row) {
+            keys.push_back(SnapshotColumn<K>::owned(snapshot.keyAt<K>(row)));
+            values.push_back(SnapshotColumn<V>::owned(snapshot.valueAt<V>(row)));
+        }
+        return map_.insertBatch(keys.data(), values.data(), count, /*assignIfExists=*/true);
+    }
+
+private:
+    Map map_;
+};
+
+// Parameters shared by every engine instantiation
+struct EngineConfig {
+    HashMap::Backend backend;
+    bool traceSteps;
+    int bucketCount;
+    HashMapGrowthPolicy policy;
+    StepLog *steps;
+};
+
+template <typename K, typename V, typename Tracer>
+std::unique_ptr<HashMapEngine> makeBackendEngine(const EngineConfig &config) {
+    switch (config.backend) {
+    case HashMap::CHAINING:
+        return std::make_unique<TypedHashMapEngine<ChainedHashMap<K, V, Tracer>>>(config.bucketCount, config.policy, config.steps);
+    case HashMap::ROBIN_HOOD:
+        return std::make_unique<TypedHashMapEngine<RobinHoodHashMap<K, V, Tracer>>>(config.bucketCount, config.policy, config.steps);
+    case HashMap::SWISS_TABLE:
+        return std::make_unique<TypedHashMapEngine<SwissHashMap<K, V, Tracer>>>(config.bucketCount, config.policy, config.steps);
+    case HashMap::CUCKOO:
+        return std::make_unique<TypedHashMapEngine<CuckooHashMap<K, V, Tracer>>>(config.bucketCount, config.policy, config.steps);
+    }
+    return nullptr;
+}
+
+template <typename K, typename V>
+std::unique_ptr<HashMapEngine> makeTypedEngine(const EngineConfig &config) {
+    if (config.traceSteps) {
+        return makeBackendEngine<K, V, StepTrace>(config);
+    }
+    return makeBackendEngine<K, V, NoStepTrace>(config);
+}
+
+template <typename K>
+std::unique_ptr<HashMapEngine> makeEngineForKey(HashMap::DataType valueType, const EngineConfig &config) {
+    switch (valueType) {
+    case HashMap::STRING: return makeTypedEngine<K, QString>(config);
+    case HashMap::INTEGER: return makeTypedEngine<K, int>(config);
+    case HashMap::DOUBLE: return makeTypedEngine<K, double>(config);
+    case HashMap::FLOAT: return makeTypedEngine<K, float>(config);
+    case HashMap::CHAR: return makeTypedEngine<K, QChar>(config);
+    }
+    return nullptr;
+}
+
+std::unique_ptr<HashMapEngine> makeEngine(HashMap::DataType keyType, HashMap::DataType valueType,
+                                          const EngineConfig &config) {
+    switch (keyType) {
+    case HashMap::STRING: return makeEngineForKey<QString>(valueType, config);
+    case HashMap::INTEGER: return makeEngineForKey<int>(valueType, config);
+    case HashMap::DOUBLE: return makeEngineForKey<double>(valueType, config);
+    case HashMap::FLOAT: return makeEngineForKey<float>(valueType, config);
+    case HashMap::CHAR: return makeEngineForKey<QChar>(valueType, config);
+    }
+    return nullptr;
+}
+
+} // namespace
+
+HashMap::HashMap(int initialBucketCount, float maxLoadFactor) {
+    growthPolicy_.maxLoadFactor = maxLoadFactor;
+    growthPolicy_.minBucketCount = std::max(1, initialBucketCount);
+    rebuildEngine(std::max(1, initialBucketCount));
+}
+
+HashMap::~HashMap() = default;
+
+void HashMap::rebuildEngine(int bucketCount) {
+    engine_ = makeEngine(keyType_, valueType_, EngineConfig{backend_, traceSteps_, bucketCount, growthPolicy_, &stepHistory_});
+    engine_->setIncrementalRehash(rehashStep_);
+    engine_->setHashStrategy(hashStrategy_);
+}
+
+void HashMap::setStepTracing(bool enabled) {
+    if (enabled == traceSteps_) return;
+    traceSteps_ = enabled;
+    rebuildEngine(bucketCount());
+}
+
+void HashMap::setGrowthPolicy(const HashMapGrowthPolicy &policy) {
+    growthPolicy_ = policy;
+    engine_->setGrowthPolicy(growthPolicy_);
+}
+
+void HashMap::reserve(int n) {
+    engine_->reserve(n);
+}
+
+void HashMap::setIncrementalRehash(int bucketsPerStep) {
+    rehashStep_ = std::max(0, bucketsPerStep);
+    engine_->setIncrementalRehash(rehashStep_);
+}
+
+bool HashMap::isRehashing() const {
+    return engine_->isRehashing();
+}
+
+void HashMap::setHashStrategy(const HashStrategy &strategy) {
+    if (strategy == hashStrategy_) return;
+    hashStrategy_ = strategy;
+    clearSteps();
+    addStep(HashMapTrace::HashSwitch, strategy.kind());
+    engine_->setHashStrategy(hashStrategy_);
+}
+
+HashDistribution HashMap::hashDistribution() const {
+    return HashDistribution::fromCounts(engine_->homeBucketCounts());
+}
+
+void HashMap::setBackend(Backend backend) {
+    if (backend == backend_) return;
+    backend_ = backend;
+    rebuildEngine(bucketCount());
+}
+
+void HashMap::setKeyType(DataType type) {
+    if (type == keyType_) return;
+    keyType_ = type;
+    rebuildEngine(bucketCount());
+}
+
+void HashMap::setValueType(DataType type) {
+    if (type == valueType_) return;
+    valueType_ = type;
+    rebuildEngine(bucketCount());
 }
 
 QString HashMap::dataTypeToString(DataType type) {
@@ -19,6 +339,16 @@ QString HashMap::dataTypeToString(DataType type) {
     }
 }
 
+QString HashMap::backendToString(Backend backend) {
+    switch (backend) {
+    case CHAINING: return "Open Chaining";
+    case ROBIN_HOOD: return "Robin Hood";
+    case SWISS_TABLE: return "Swiss Table";
+    case CUCKOO: return "Cuckoo";
+    default: return "Unknown";
+    }
+}
+
 QString HashMap::variantToDisplayString(const QVariant &var) {
     if (var.type() == QVariant::String) {
         return var.toString();
@@ -26,100 +356,20 @@ QString HashMap::variantToDisplayString(const QVariant &var) {
         return QString::number(var.toInt());
     } else if (var.type() == QVariant::Double) {
         return QString::number(var.toDouble(), 'f', 2);
-    } else if (var.canConvert<float>()) {
-        return QString::number(var.toFloat(), 'f', 2);
     } else if (var.type() == QVariant::Char) {
         return QString(var.toChar());
+    } else if (var.canConvert<float>()) {
+        return QString::number(var.toFloat(), 'f', 2);
     }
     return var.toString();
 }
 
 int HashMap::indexFor(const QVariant &key, int bucketCount) const {
-    size_t hashValue = 0;
-
-    // Use std::hash-like behavior to mirror unordered_map hashing
-    switch (key.type()) {
-    case QVariant::String: {
-        const std::string s = key.toString().toStdString();
-        hashValue = std::hash<std::string>{}(s);
-        break;
-    }
-    case QVariant::Int: {
-        const int v = key.toInt();
-        hashValue = std::hash<int>{}(v);
-        break;
-    }
-    case QVariant::Double: {
-        // QVariant stores float as double by default; both map through std::hash<double>
-        const double v = key.toDouble();
-        hashValue = std::hash<double>{}(v);
-        break;
-    }
-    case QVariant::Char: {
-        const QChar qc = key.toChar();
-        const char c = qc.toLatin1();
-        hashValue = std::hash<char>{}(c);
-        break;
-    }
-    default: {
-        // Try float explicitly if convertible
-        if (key.canConvert<float>()) {
-            const float v = key.toFloat();
-            hashValue = std::hash<float>{}(v);
-        } else {
-            // Fallback to string representation
-            const std::string s = key.toString().toStdString();
-            hashValue = std::hash<std::string>{}(s);
-        }
-        break;
-    }
-    }
-
-    // bucket_index = hash(key) % bucketCount
-    return static_cast<int>(hashValue % static_cast<size_t>(bucketCount));
+    return engine_->indexFor(key, bucketCount);
 }
 
 size_t HashMap::getHashValue(const QVariant &key) const {
-    size_t hashValue = 0;
-
-    // Use std::hash-like behavior to mirror unordered_map hashing
-    switch (key.type()) {
-    case QVariant::String: {
-        const std::string s = key.toString().toStdString();
-        hashValue = std::hash<std::string>{}(s);
-        break;
-    }
-    case QVariant::Int: {
-        const int v = key.toInt();
-        hashValue = std::hash<int>{}(v);
-        break;
-    }
-    case QVariant::Double: {
-        const double v = key.toDouble();
-        hashValue = std::hash<double>{}(v);
-        break;
-    }
-    case QVariant::Char: {
-        const QChar qc = key.toChar();
-        const char c = qc.toLatin1();
-        hashValue = std::hash<char>{}(c);
-        break;
-    }
-    default: {
-        // Try float explicitly if convertible
-        if (key.canConvert<float>()) {
-            const float v = key.toFloat();
-            hashValue = std::hash<float>{}(v);
-        } else {
-            // Fallback to string representation
-            const std::string s = key.toString().toStdString();
-            hashValue = std::hash<std::string>{}(s);
-        }
-        break;
-    }
-    }
-
-    return hashValue;
+    return engine_->hashOf(key);
 }
 
 bool HashMap::validateType(const QVariant &value, DataType expectedType) const {
@@ -139,275 +389,223 @@ bool HashMap::validateType(const QVariant &value, DataType expectedType) const {
     }
 }
 
-void HashMap::addStep(const QString &text) {
-    stepHistory_.append(text);
+void HashMap::addStep(HashMapTrace::Op op, int result, int bucket, quint16 flags, quint64 hash) {
+    if (!traceSteps_) return;
+    StepEvent event;
+    event.op = op;
+    event.flags = flags;
+    event.bucket = bucket;
+    event.result = result;
+    event.hash = hash;
+    stepHistory_.append(event);
 }
 
 void HashMap::addStepToHistory(const QString &step) {
-    stepHistory_.append(step);
+    stepHistory_.appendText(step);
 }
 
 void HashMap::clearSteps() {
     // Don't clear history, just mark a separator
-    stepHistory_.append("────────────────────");
+    if (traceSteps_) stepHistory_.appendSeparator();
 }
 
-const QVector<QString> &HashMap::lastSteps() const {
+const StepLog &HashMap::lastSteps() const {
     return stepHistory_;
 }
 
 int HashMap::size() const {
-    return numElements_;
+    return engine_->size();
 }
 
 int HashMap::bucketCount() const {
-    return static_cast<int>(buckets_.size());
+    return engine_->bucketCount();
 }
 
 float HashMap::loadFactor() const {
-    if (buckets_.empty()) return 0.0f;
-    return static_cast<float>(numElements_) / static_cast<float>(buckets_.size());
+    return engine_->loadFactor();
 }
 
-void HashMap::maybeGrow() {
-    // Only rehash once - if we've already rehashed, don't do it again
-    if (hasRehashed_) {
-        return;
-    }
-    
-    const float projected = (static_cast<float>(numElements_) + 1.0f)
-    / static_cast<float>(buckets_.empty() ? 1 : buckets_.size());
-    if (projected > maxLoadFactor_) {
-        const int newCount = std::max(2, bucketCount() * 2);
-        addStep(QStringLiteral("Load factor %.2f exceeds %.2f → rehash to %1 buckets")
-                    .arg(newCount)
-                    .arg(loadFactor(), 0, 'f', 2)
-                    .arg(maxLoadFactor_, 0, 'f', 2));
-        rehash(newCount);
-        hasRehashed_ = true;  // Mark that we've rehashed
+bool HashMap::insert(const QVariant &key, const QVariant &value) {
+    addStep(HashMapTrace::BeginInsert);
+    if (!validateType(key, keyType_) || !validateType(value, valueType_)) {
+        addStep(HashMapTrace::TypeMismatch);
+        clearSteps();
+        return false;
     }
+    bool result = engine_->insert(key, value);
+    clearSteps();
+    return result;
 }
 
-bool HashMap::emplaceOrAssign(const QVariant &key, const QVariant &value, bool assignIfExists) {
-    // Validate types
+void HashMap::put(const QVariant &key, const QVariant &value) {
+    addStep(HashMapTrace::BeginPut);
     if (!validateType(key, keyType_) || !validateType(value, valueType_)) {
-        addStep(QStringLiteral("Type validation failed"));
-        return false;
+        addStep(HashMapTrace::TypeMismatch);
+        clearSteps();
+        return;
     }
+    (void)engine_->put(key, value);
+    clearSteps();
+}
 
-    const int bucketCountNow = bucketCount();
-
-    QString keyStr = variantToDisplayString(key);
-    QString valueStr = variantToDisplayString(value);
-
-    // Use our custom indexFor method which shows the simple hash
-    const int index = indexFor(key, bucketCountNow);
-    const size_t computedHash = getHashValue(key);
+std::optional<QVariant> HashMap::get(const QVariant &key) {
+    addStep(HashMapTrace::BeginSearch);
+    std::optional<QVariant> result = engine_->get(key);
+    clearSteps();
+    return result;
+}
 
-    // Show hash calculation with computed hash value
-    if (key.type() == QVariant::Int || key.type() == QVariant::Double) {
-        addStep(QString("📊 Compute hash(%1) = %2").arg(keyStr).arg(computedHash));
-        addStep(QString("📐 Calculate: %2 % %1 = %3").arg(bucketCountNow).arg(computedHash).arg(index));
-    } else {
-        addStep(QString("📊 Compute hash for: \"%1\" = %2").arg(keyStr).arg(computedHash));
-        addStep(QString("📐 Index = %2 % %1 = %3").arg(bucketCountNow).arg(computedHash).arg(index));
-    }
-    addStep(QStringLiteral("Visit bucket %1").arg(index));
-
-    auto &chain = buckets_[static_cast<size_t>(index)];
-    for (auto &node : chain) {
-        QString nodeKeyStr = variantToDisplayString(node.key);
-        addStep(QStringLiteral("Compare keys: %1 == %2 ? %3")
-                    .arg(nodeKeyStr, keyStr, node.key == key ? QStringLiteral("Yes") : QStringLiteral("No")));
-        if (node.key == key) {
-            if (assignIfExists) {
-                QString oldValueStr = variantToDisplayString(node.value);
-                addStep(QStringLiteral("Key exists → update value: %1 → %2").arg(oldValueStr, valueStr));
-                node.value = value;
-            } else {
-                addStep(QStringLiteral("Key exists → no insert (duplicate)"));
-            }
-            return false; // not a new insertion
-        }
-        addStep(QStringLiteral("Traverse next in chain"));
-    }
+bool HashMap::erase(const QVariant &key) {
+    addStep(HashMapTrace::BeginDelete);
+    bool removed = engine_->erase(key);
+    clearSteps();
+    return removed;
+}
 
-    addStep(QStringLiteral("Append new node to bucket %1").arg(index));
-    chain.push_front(Node{key, value});
-    ++numElements_;
-    addStep(QStringLiteral("New size = %1, load factor = %2")
-                .arg(numElements_)
-                .arg(loadFactor(), 0, 'f', 2));
-    return true;
+bool HashMap::contains(const QVariant &key) {
+    return get(key).has_value();
 }
 
-bool HashMap::insert(const QVariant &key, const QVariant &value) {
-    addStep(QStringLiteral("➕ INSERT OPERATION"));
-    maybeGrow();
-    bool result = emplaceOrAssign(key, value, /*assignIfExists=*/false);
+std::optional<QVariant> HashMap::get(QStringView key) {
+    addStep(HashMapTrace::BeginSearch);
+    std::optional<QVariant> result = engine_->get(key);
     clearSteps();
     return result;
 }
 
-void HashMap::put(const QVariant &key, const QVariant &value) {
-    addStep(QStringLiteral("➕ PUT OPERATION"));
-    maybeGrow();
-    (void)emplaceOrAssign(key, value, /*assignIfExists=*/true);
+bool HashMap::erase(QStringView key) {
+    addStep(HashMapTrace::BeginDelete);
+    bool removed = engine_->erase(key);
     clearSteps();
+    return removed;
 }
 
-std::optional<QVariant> HashMap::get(const QVariant &key) {
-    addStep(QStringLiteral("🔍 SEARCH OPERATION"));
-    if (buckets_.empty()) {
-        addStep(QStringLiteral("Table is empty → not found"));
-        clearSteps();
-        return std::nullopt;
-    }
+bool HashMap::contains(QStringView key) {
+    return get(key).has_value();
+}
 
-    const int bucketCountNow = bucketCount();
+int HashMap::insertBatch(const QVector<QVariant> &keys, const QVector<QVariant> &values) {
+    return insertPairs(keys, values, /*assignIfExists=*/false);
+}
 
-    QString keyStr = variantToDisplayString(key);
+int HashMap::putBatch(const QVector<QVariant> &keys, const QVector<QVariant> &values) {
+    return insertPairs(keys, values, /*assignIfExists=*/true);
+}
 
-    // Use our custom indexFor method
-    const int index = indexFor(key, bucketCountNow);
-    const size_t computedHash = getHashValue(key);
+int HashMap::insertPairs(const QVector<QVariant> &keys, const QVector<QVariant> &values, bool assignIfExists) {
+    const int count = std::min(keys.size(), values.size());
+    addStep(assignIfExists ? HashMapTrace::BeginBatchPut : HashMapTrace::BeginBatchInsert, count);
 
-    // Show hash calculation with computed hash value
-    if (key.type() == QVariant::Int || key.type() == QVariant::Double) {
-        addStep(QString("📊 Compute hash(%1) = %2").arg(keyStr).arg(computedHash));
-        addStep(QString("📐 Calculate: %2 % %1 = %3").arg(bucketCountNow).arg(computedHash).arg(index));
-    } else {
-        addStep(QString("📊 Compute hash for: \"%1\" = %2").arg(keyStr).arg(computedHash));
-        addStep(QString("📐 Index = %2 % %1 = %3").arg(bucketCountNow).arg(computedHash).arg(index));
+    int skipped = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!validateType(keys[i], keyType_) || !validateType(values[i], valueType_)) ++skipped;
     }
-    addStep(QString("🎯 Visit bucket %1").arg(index));
-
-    const auto &chain = buckets_[static_cast<size_t>(index)];
-    for (const auto &node : chain) {
-        QString nodeKeyStr = variantToDisplayString(node.key);
-        addStep(QStringLiteral("Compare keys: %1 == %2 ? %3")
-                    .arg(nodeKeyStr, keyStr, node.key == key ? QStringLiteral("Yes") : QStringLiteral("No")));
-        if (node.key == key) {
-            QString valueStr = variantToDisplayString(node.value);
-            addStep(QStringLiteral("Found → return value %1").arg(valueStr));
-            clearSteps();
-            return node.value;
+
+    const int bucketsBefore = bucketCount();
+    int added = 0;
+    if (skipped == 0) {
+        added = engine_->insertBatch(keys.constData(), values.constData(), count, assignIfExists);
+    } else {
+        // Only copy the lists when some pairs have to be dropped
+        QVector<QVariant> validKeys;
+        QVector<QVariant> validValues;
+        validKeys.reserve(count - skipped);
+        validValues.reserve(count - skipped);
+        for (int i = 0; i < count; ++i) {
+            if (validateType(keys[i], keyType_) && validateType(values[i], valueType_)) {
+                validKeys.push_back(keys[i]);
+                validValues.push_back(values[i]);
+            }
         }
-        addStep(QStringLiteral("Traverse next in chain"));
+        addStep(HashMapTrace::BatchSkipped, skipped);
+        added = engine_->insertBatch(validKeys.constData(), validValues.constData(), validKeys.size(), assignIfExists);
+    }
+
+    if (bucketCount() != bucketsBefore) {
+        addStep(HashMapTrace::BatchResized, bucketsBefore, bucketCount(),
+                backend_ == CHAINING ? 0 : HashMapTrace::SlotUnit);
     }
-    addStep(QStringLiteral("Reached end of chain → not found"));
+    addStep(HashMapTrace::BatchInserted, added, bucketCount(), 0, static_cast<quint64>(size()));
     clearSteps();
-    return std::nullopt;
+    return added;
 }
 
-bool HashMap::erase(const QVariant &key) {
-    addStep(QStringLiteral("🗑️ DELETE OPERATION"));
-    if (buckets_.empty()) {
-        addStep(QStringLiteral("Table is empty → nothing to erase"));
-        clearSteps();
-        return false;
-    }
+QVector<std::optional<QVariant>> HashMap::getBatch(const QVector<QVariant> &keys) {
+    addStep(HashMapTrace::BeginBatchSearch, keys.size());
+    QVector<std::optional<QVariant>> results = engine_->getBatch(keys.constData(), keys.size());
+    const int found = static_cast<int>(std::count_if(results.cbegin(), results.cend(),
+                                                     [](const std::optional<QVariant> &r) { return r.has_value(); }));
+    addStep(HashMapTrace::BatchFound, found, keys.size());
+    clearSteps();
+    return results;
+}
 
-    const int bucketCountNow = bucketCount();
 
-    QString keyStr = variantToDisplayString(key);
+void HashMap::clear() {
+    clearSteps();
+    engine_->clear();
+    addStep(HashMapTrace::Cleared);
+}
 
-    // Use our custom indexFor method
-    const int index = indexFor(key, bucketCountNow);
-    const size_t computedHash = getHashValue(key);
+void HashMap::rehash(int newBucketCount) {
+    engine_->rehash(newBucketCount);
+}
 
-    // Show hash calculation for delete operation with computed hash value
-    if (key.type() == QVariant::Int || key.type() == QVariant::Double) {
-        addStep(QString("📊 Compute hash(%1) = %2").arg(keyStr).arg(computedHash));
-        addStep(QString("📐 Calculate: %2 % %1 = %3").arg(bucketCountNow).arg(computedHash).arg(index));
-    } else {
-        addStep(QString("📊 Compute hash for: \"%1\" = %2").arg(keyStr).arg(computedHash));
-        addStep(QString("📐 Index = %2 % %1 = %3").arg(bucketCountNow).arg(computedHash).arg(index));
-    }
-    addStep(QStringLiteral("Visit bucket %1").arg(index));
-
-    auto &chain = buckets_[static_cast<size_t>(index)];
-    auto before = chain.before_begin();
-    for (auto it = chain.begin(); it != chain.end(); ++it) {
-        QString nodeKeyStr = variantToDisplayString(it->key);
-        addStep(QStringLiteral("Compare keys: %1 == %2 ? %3")
-                    .arg(nodeKeyStr, keyStr, it->key == key ? QStringLiteral("Yes") : QStringLiteral("No")));
-        if (it->key == key) {
-            chain.erase_after(before);
-            --numElements_;
-            addStep(QStringLiteral("Erased node. New size = %1, load factor = %2")
-                        .arg(numElements_)
-                        .arg(loadFactor(), 0, 'f', 2));
-            clearSteps();
-            return true;
-        }
-        ++before;
-        addStep(QStringLiteral("Traverse next in chain"));
-    }
-    addStep(QStringLiteral("Reached end of chain → key not found"));
-    clearSteps();
-    return false;
+QVector<int> HashMap::bucketSizes() const {
+    return engine_->bucketSizes();
 }
 
-bool HashMap::contains(const QVariant &key) {
-    return get(key).has_value();
+QVector<int> HashMap::chainLengthHistogram() const {
+    return engine_->chainLengthHistogram();
+}
+
+int HashMap::maxChainLength() const {
+    return engine_->maxChainLength();
 }
 
+int HashMap::maxKickChain() const {
+    return engine_->maxKickChain();
+}
+
+bool HashMap::saveSnapshot(const QString &path, QString *error) const {
+    return engine_->writeSnapshot(path, hashStrategy_, error);
+}
+
+int HashMap::loadSnapshot(const HashMapSnapshot &snapshot) {
+    if (!snapshot.isOpen()) return 0;
+
+    keyType_ = snapshot.keyType();
+    valueType_ = snapshot.valueType();
+    hashStrategy_ = snapshot.hashStrategy();
+    rebuildEngine(growthPolicy_.bucketsFor(snapshot.size()));
 
-void HashMap::clear() {
     clearSteps();
-    for (auto &chain : buckets_) {
-        chain.clear();
-    }
-    numElements_ = 0;
-    hasRehashed_ = false;  // Reset rehash flag when clearing
-    addStep(QStringLiteral("Cleared all buckets"));
+    const int loaded = engine_->loadSnapshot(snapshot);
+    addStep(HashMapTrace::SnapshotLoaded, loaded, bucketCount(), backend_ == CHAINING ? 0 : HashMapTrace::SlotUnit);
+    clearSteps();
+    return loaded;
 }
 
-void HashMap::rehash(int newBucketCount) {
-    if (newBucketCount < 1) newBucketCount = 1;
-    QVector<QString> rehashSteps;
-    rehashSteps.push_back(QStringLiteral("Rehashing to %1 buckets").arg(newBucketCount));
-
-    std::vector<std::forward_list<Node>> newBuckets(static_cast<size_t>(newBucketCount));
-    for (auto &chain : buckets_) {
-        for (auto &node : chain) {
-            const int newIndex = indexFor(node.key, newBucketCount);
-            rehashSteps.append(QStringLiteral("Move (%1,%2) → bucket %3")
-                                   .arg(variantToDisplayString(node.key), variantToDisplayString(node.value))
-                                   .arg(newIndex));
-            newBuckets[static_cast<size_t>(newIndex)].push_front(Node{std::move(node.key), std::move(node.value)});
-        }
-    }
-    buckets_.swap(newBuckets);
-    // Append rehash steps to the live steps log.
-    for (const auto &s : rehashSteps) stepHistory_.append(s);
+int HashMap::forEachInBucket(int bucket, const EntryVisitor &visit, int maxEntries) const {
+    if (bucket < 0 || bucket >= bucketCount()) return 0;
+    return engine_->forEachInBucket(bucket, visit, maxEntries);
 }
 
-QVector<int> HashMap::bucketSizes() const {
-    QVector<int> sizes;
-    sizes.reserve(static_cast<int>(buckets_.size()));
-    for (const auto &chain : buckets_) {
-        int count = 0;
-        for (const auto &n : chain) {
-            (void)n; // suppress unused variable warning
-            ++count;
-        }
-        sizes.push_back(count);
-    }
-    return sizes;
+int HashMap::bucketEntryCount(int bucket) const {
+    if (bucket < 0 || bucket >= bucketCount()) return 0;
+    return engine_->bucketEntryCount(bucket);
 }
 
-QVector<QVector<QPair<QVariant, QVariant>>> HashMap::getBucketContents() const {
-    QVector<QVector<QPair<QVariant, QVariant>>> contents;
-    contents.reserve(static_cast<int>(buckets_.size()));
-    for (const auto &chain : buckets_) {
-        QVector<QPair<QVariant, QVariant>> bucketItems;
-        for (const auto &node : chain) {
-            bucketItems.push_back(QPair<QVariant, QVariant>(node.key, node.value));
-        }
-        contents.push_back(bucketItems);
-    }
-    return contents;
+HashMapDirtySet HashMap::takeDirtyBuckets() {
+    return engine_->takeDirtyBuckets();
 }
 
+HashMap::BucketView HashMap::bucketView(int bucket, int maxEntries) const {
+    BucketView view;
+    view.total_ = bucketEntryCount(bucket);
+    view.entries_.reserve(maxEntries < 0 ? view.total_ : std::min(view.total_, maxEntries));
+    forEachInBucket(bucket, [&view](const QVariant &key, const QVariant &value) {
+        view.entries_.push_back(BucketView::Entry(key, value));
+    }, maxEntries);
+    return view;
+}
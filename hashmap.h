@@ -3,17 +3,25 @@
 #include <QString>
 #include <QVector>
 #include <QVariant>
+#include <QStringView>
 #include <QHashFunctions>
-#include <forward_list>
-#include <optional>
-#include <vector>
-#include <algorithm>
-#include <cmath>
 #include <functional>
-#include <string>
+#include <memory>
+#include <optional>
+#include "hashmapdirtyset.h"
+#include "hashmaptrace.h"
+#include "hashmappolicy.h"
+#include "hashstrategy.h"
+
+class HashMapEngine;
+class HashMapSnapshot;
 
 // Hash Map supporting multiple data types for keys and values.
 // Instrumented with a human-readable step trace for visualization.
+// This is a type-erased front end: each call converts its QVariant arguments
+// once and forwards them to a typed engine (ChainedHashMap<K, V>,
+// RobinHoodHashMap<K, V>, SwissHashMap<K, V> or CuckooHashMap<K, V>)
+// instantiated for the selected key/value types.
 class HashMap {
 public:
     enum DataType {
@@ -24,14 +32,38 @@ public:
         CHAR
     };
 
+    // Collision-resolution strategy backing the map
+    enum Backend {
+        CHAINING,    // Separate chaining (pooled node chain per bucket)
+        ROBIN_HOOD,  // Open addressing, Robin Hood probing in a flat slot array
+        SWISS_TABLE, // Open addressing, SIMD probing of 16-slot control-byte groups
+        CUCKOO       // Two tables plus a stash; lookups read at most two slots
+    };
+
+    // initialBucketCount is also the floor for shrinking; other growth
+    // settings start at their HashMapGrowthPolicy defaults
     explicit HashMap(int initialBucketCount = 16, float maxLoadFactor = 0.75f);
+    ~HashMap();
+
+    HashMap(const HashMap &) = delete;
+    HashMap &operator=(const HashMap &) = delete;
 
-    // Set data types for key and value
-    void setKeyType(DataType type) { keyType_ = type; }
-    void setValueType(DataType type) { valueType_ = type; }
+    // Set data types for key and value (changing a type discards the contents)
+    void setKeyType(DataType type);
+    void setValueType(DataType type);
     DataType getKeyType() const { return keyType_; }
     DataType getValueType() const { return valueType_; }
 
+    // Select the storage backend (changing it discards the contents)
+    void setBackend(Backend backend);
+    Backend getBackend() const { return backend_; }
+
+    // Step recording for the visualizer (on by default). When off, the engine
+    // is instantiated with NoStepTrace and no step is recorded; toggling
+    // discards the contents.
+    void setStepTracing(bool enabled);
+    bool isStepTracing() const { return traceSteps_; }
+
     // Generic insert/put methods using QVariant
     bool insert(const QVariant &key, const QVariant &value);
     void put(const QVariant &key, const QVariant &value);
@@ -39,6 +71,30 @@ public:
     bool erase(const QVariant &key);
     bool contains(const QVariant &key);
 
+    // Heterogeneous lookups for string keys: the view is hashed and compared
+    // in place. Other key types convert the text as the QVariant API would.
+    std::optional<QVariant> get(QStringView key);
+    bool erase(QStringView key);
+    bool contains(QStringView key);
+    // A QString converts to both QVariant and QStringView; take the view path
+    std::optional<QVariant> get(const QString &key) { return get(QStringView(key)); }
+    bool erase(const QString &key) { return erase(QStringView(key)); }
+    bool contains(const QString &key) { return contains(QStringView(key)); }
+    // Literals would be ambiguous between the QVariant and QString overloads
+    std::optional<QVariant> get(const char *key) { return get(QString::fromUtf8(key)); }
+    bool erase(const char *key) { return erase(QString::fromUtf8(key)); }
+    bool contains(const char *key) { return contains(QString::fromUtf8(key)); }
+
+    // Bulk operations over parallel key/value lists (pairs beyond the
+    // shorter list are ignored). The table is presized once, every key is
+    // hashed before any is probed, and buckets are prefetched a few keys
+    // ahead. Only summary steps are recorded. Pairs that fail type
+    // validation are skipped. Return the number of new keys.
+    int insertBatch(const QVector<QVariant> &keys, const QVector<QVariant> &values);
+    int putBatch(const QVector<QVariant> &keys, const QVector<QVariant> &values);
+    // One result per key, std::nullopt where the key is absent
+    QVector<std::optional<QVariant>> getBatch(const QVector<QVariant> &keys);
+
     void clear();
 
     int size() const;
@@ -47,15 +103,92 @@ public:
 
     void rehash(int newBucketCount);
 
-    // Visualization helpers
-    const QVector<QString> &lastSteps() const;
+    // Grow/shrink thresholds, growth factor and bucket reducer; kept across
+    // engine rebuilds. A new reducer re-indexes the current contents.
+    void setGrowthPolicy(const HashMapGrowthPolicy &policy);
+    const HashMapGrowthPolicy &growthPolicy() const { return growthPolicy_; }
+    // Grows the table now so n entries fit under the max load factor
+    void reserve(int n);
+
+    // Incremental growth for the chaining backend: when the load factor is
+    // exceeded the old and new bucket vectors coexist, and every later
+    // operation migrates up to bucketsPerStep old buckets before running.
+    // 0 (the default) rehashes the whole table at once. Ignored by the open
+    // addressing backends.
+    void setIncrementalRehash(int bucketsPerStep);
+    int incrementalRehashStep() const { return rehashStep_; }
+    bool isRehashing() const;
+
+    // Hash function applied on top of the per-type base hash. Switching
+    // rehashes the current contents in place; kept across engine rebuilds.
+    void setHashStrategy(const HashStrategy &strategy);
+    const HashStrategy &hashStrategy() const { return hashStrategy_; }
+    // Chi-squared and longest run over home buckets (home groups for the
+    // Swiss table), for comparing hash functions on the same keys
+    HashDistribution hashDistribution() const;
+
+    // Binary snapshots (see hashmapsnapshot.h). saveSnapshot writes the
+    // current contents and returns false with a reason in *error on failure.
+    // loadSnapshot replaces the contents with an open snapshot's rows through
+    // the batch path, adopting its key/value types and hash strategy, and
+    // returns the number of entries loaded.
+    bool saveSnapshot(const QString &path, QString *error = nullptr) const;
+    int loadSnapshot(const HashMapSnapshot &snapshot);
+
+    // Visualization helpers. Steps are stored as compact events and rendered
+    // with StepLog::text() when displayed.
+    const StepLog &lastSteps() const;
     void clearSteps();
     void addStepToHistory(const QString &step);
+    // Entries per bucket for chaining; probe-sequence length per slot for
+    // Robin Hood; 1/0 slot occupancy for the Swiss table and cuckoo
     QVector<int> bucketSizes() const;
-    QVector<QVector<QPair<QVariant, QVariant>>> getBucketContents() const;
+    // Histogram of bucketSizes() values (index = length, value = buckets)
+    // and its largest length. Chaining keeps both current on every insert,
+    // erase and rehash; the open addressing backends derive them in O(slots).
+    QVector<int> chainLengthHistogram() const;
+    int maxChainLength() const;
+    // Cuckoo only: longest chain of displacements one insert caused since
+    // the tables were last built (0 for the other backends)
+    int maxKickChain() const;
+
+    // Reads one bucket in place, without copying the table: visit runs for
+    // each entry in chain order (for chaining, followed by entries still
+    // waiting in the old table during an incremental rehash). Stops after
+    // maxEntries (-1 visits all); returns the number visited.
+    using EntryVisitor = std::function<void(const QVariant &key, const QVariant &value)>;
+    int forEachInBucket(int bucket, const EntryVisitor &visit, int maxEntries = -1) const;
+    // Number of entries forEachInBucket would visit without a cap
+    int bucketEntryCount(int bucket) const;
+
+    // Range over the first maxEntries entries of one bucket; only those are
+    // converted. total() still counts the entries past the cap.
+    class BucketView {
+    public:
+        using Entry = QPair<QVariant, QVariant>;
+        using const_iterator = QVector<Entry>::const_iterator;
+
+        const_iterator begin() const { return entries_.begin(); }
+        const_iterator end() const { return entries_.end(); }
+        int size() const { return entries_.size(); }
+        bool isEmpty() const { return entries_.isEmpty(); }
+        int total() const { return total_; }
+
+    private:
+        friend class HashMap;
+        QVector<Entry> entries_;
+        int total_ = 0;
+    };
+    BucketView bucketView(int bucket, int maxEntries = -1) const;
+
+    // Buckets (slots for open addressing) whose contents changed since the
+    // last call, and resets the set. A new backend, type or table shape
+    // reports every bucket, as does an untraced map.
+    HashMapDirtySet takeDirtyBuckets();
 
     // Type conversion helpers
     static QString dataTypeToString(DataType type);
+    static QString backendToString(Backend backend);
     static QString variantToDisplayString(const QVariant &var);
     // Hash function (public for visualization)
     int indexFor(const QVariant &key, int bucketCount) const;
@@ -63,22 +196,19 @@ public:
     size_t getHashValue(const QVariant &key) const;
 
 private:
-    struct Node {
-        QVariant key;
-        QVariant value;
-    };
-
-    std::vector<std::forward_list<Node>> buckets_;
-    int numElements_ = 0;
-    float maxLoadFactor_ = 0.75f;
-    QVector<QString> stepHistory_;  // Persistent history
+    std::unique_ptr<HashMapEngine> engine_;
+    HashMapGrowthPolicy growthPolicy_;
+    HashStrategy hashStrategy_;
+    StepLog stepHistory_{&HashMapTrace::render, &HashMapTrace::category};  // Persistent history
     DataType keyType_ = STRING;
     DataType valueType_ = STRING;
-    bool hasRehashed_ = false;  // Track if rehashing has occurred (only once)
+    Backend backend_ = CHAINING;
+    bool traceSteps_ = true;
+    int rehashStep_ = 0;
 
-    void addStep(const QString &text);
-    bool emplaceOrAssign(const QVariant &key, const QVariant &value, bool assignIfExists);
-    void maybeGrow();
+    void addStep(HashMapTrace::Op op, int result = 0, int bucket = -1, quint16 flags = 0, quint64 hash = 0);
+    int insertPairs(const QVector<QVariant> &keys, const QVector<QVariant> &values, bool assignIfExists);
+    void rebuildEngine(int bucketCount);
     bool validateType(const QVariant &value, DataType expectedType) const;
 };
 
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QVector>
+#include <algorithm>
+#include <vector>
+
+// Chain lengths of one bucket array, kept current as entries are linked and
+// unlinked so occupancy queries never walk the chains. Alongside the
+// per-bucket lengths it keeps a histogram (buckets per chain length) and the
+// longest chain; every update is O(1) amortized.
+class HashMapChainStats {
+public:
+    explicit HashMapChainStats(int bucketCount = 0) { reset(bucketCount); }
+
+    // All buckets empty
+    void reset(int bucketCount) {
+        lengths_.assign(static_cast<size_t>(std::max(0, bucketCount)), 0);
+        histogram_.assign(1, bucketCount);
+        maxLength_ = 0;
+    }
+
+    void added(int bucket) {
+        int &length = lengths_[static_cast<size_t>(bucket)];
+        --histogram_[static_cast<size_t>(length)];
+        ++length;
+        if (static_cast<size_t>(length) == histogram_.size()) histogram_.push_back(0);
+        ++histogram_[static_cast<size_t>(length)];
+        maxLength_ = std::max(maxLength_, length);
+    }
+
+    void removed(int bucket) {
+        int &length = lengths_[static_cast<size_t>(bucket)];
+        --histogram_[static_cast<size_t>(length)];
+        --length;
+        ++histogram_[static_cast<size_t>(length)];
+        dropEmptyMax();
+    }
+
+    // The whole chain moved elsewhere
+    void emptied(int bucket) {
+        int &length = lengths_[static_cast<size_t>(bucket)];
+        --histogram_[static_cast<size_t>(length)];
+        length = 0;
+        ++histogram_[0];
+        dropEmptyMax();
+    }
+
+    int bucketCount() const { return static_cast<int>(lengths_.size()); }
+    int length(int bucket) const { return lengths_[static_cast<size_t>(bucket)]; }
+    int maxLength() const { return maxLength_; }
+
+    QVector<int> lengths() const { return QVector<int>(lengths_.begin(), lengths_.end()); }
+
+    // histogram[k] = number of buckets holding exactly k entries, up to maxLength()
+    QVector<int> histogram() const {
+        return QVector<int>(histogram_.begin(), histogram_.begin() + maxLength_ + 1);
+    }
+
+    // Same histogram built from a plain list of lengths in one pass, for
+    // tables that do not track them
+    static QVector<int> histogramOf(const QVector<int> &lengths) {
+        QVector<int> histogram(1, 0);
+        for (int length : lengths) {
+            if (length >= histogram.size()) histogram.resize(length + 1);
+            ++histogram[length];
+        }
+        return histogram;
+    }
+
+private:
+    std::vector<int> lengths_;
+    std::vector<int> histogram_;  // may keep zero counts past maxLength_
+    int maxLength_ = 0;
+
+    // Lengths only move by one (or to zero), so the scan is short on average
+    void dropEmptyMax() {
+        while (maxLength_ > 0 && histogram_[static_cast<size_t>(maxLength_)] == 0) --maxLength_;
+    }
+};
@@ -0,0 +1,846 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QVariant>
+#include <QChar>
+#include <QStringView>
+#include "hashmaptrace.h"
+#include "hashmappolicy.h"
+#include "hashmapnodepool.h"
+#include "hashmapchainstats.h"
+#include "hashmapdirtyset.h"
+#include "hashstrategy.h"
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+// Hint that address will be read soon. Batch operations issue it for the
+// bucket of a key a few positions ahead of the one being probed.
+inline void prefetchForRead(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 1);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+// Per-type policy for the typed hash map engine: hashing, display and
+// conversion from the QVariant front end. Numeric and char hashes mirror the
+// std::hash calls of the original QVariant implementation.
+template <typename T>
+struct HashMapTraits;
+
+// Strings hash their UTF-16 buffer in place (no temporary std::string), and
+// QStringView hashes identically so it can be used for lookups
+template <>
+struct HashMapTraits<QString> {
+    static constexpr bool numeric = false;
+    static size_t hash(QStringView v) {
+        return std::hash<std::u16string_view>{}(
+            std::u16string_view(reinterpret_cast<const char16_t *>(v.utf16()), static_cast<size_t>(v.size())));
+    }
+    static QString display(const QString &v) { return v; }
+    static QString fromVariant(const QVariant &v) { return v.toString(); }
+};
+
+template <>
+struct HashMapTraits<int> {
+    static constexpr bool numeric = true;
+    static size_t hash(int v) { return std::hash<int>{}(v); }
+    static QString display(int v) { return QString::number(v); }
+    static int fromVariant(const QVariant &v) { return v.toInt(); }
+};
+
+template <>
+struct HashMapTraits<double> {
+    static constexpr bool numeric = true;
+    static size_t hash(double v) { return std::hash<double>{}(v); }
+    static QString display(double v) { return QString::number(v, 'f', 2); }
+    static double fromVariant(const QVariant &v) { return v.toDouble(); }
+};
+
+template <>
+struct HashMapTraits<float> {
+    static constexpr bool numeric = true;
+    static size_t hash(float v) { return std::hash<float>{}(v); }
+    static QString display(float v) { return QString::number(v, 'f', 2); }
+    static float fromVariant(const QVariant &v) { return v.toFloat(); }
+};
+
+template <>
+struct HashMapTraits<QChar> {
+    static constexpr bool numeric = false;
+    static size_t hash(QChar v) { return std::hash<char>{}(v.toLatin1()); }
+    static QString display(QChar v) { return QString(v); }
+    static QChar fromVariant(const QVariant &v) { return v.toChar(); }
+};
+
+// Owning key for a heterogeneous lookup key; only needed to trace it
+template <typename K, typename Q>
+K ownedKey(const Q &key) {
+    if constexpr (std::is_same_v<Q, QStringView>) {
+        return key.toString();
+    } else {
+        return K(key);
+    }
+}
+
+// Multiplicative finalizer for consumers that slice the hash into fields
+// (Swiss H1/H2, concurrent shard bits). std::hash is the identity for
+// integers, so without it those fields would carry no entropy.
+inline size_t mixHash(size_t hash) {
+    const quint64 h = static_cast<quint64>(hash) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(h ^ (h >> 32));
+}
+
+// Bucket index of a full hash under the selected reducer. reducedHash is
+// the value the reducer actually operates on (shown in the trace).
+inline size_t reducedHash(size_t hash, HashMapBucketReducer reducer) {
+    return reducer == HashMapBucketReducer::Modulo ? hash : mixHash(hash);
+}
+
+inline int reduceHash(size_t hash, int bucketCount, HashMapBucketReducer reducer) {
+    switch (reducer) {
+    case HashMapBucketReducer::Mask:
+        return static_cast<int>(mixHash(hash) & static_cast<size_t>(bucketCount - 1));
+    case HashMapBucketReducer::FastRange: {
+        if constexpr (sizeof(size_t) < sizeof(quint64)) {
+            return static_cast<int>((static_cast<quint64>(mixHash(hash)) * static_cast<quint64>(bucketCount)) >> 32);
+        }
+        quint64 low = 0, high = 0;
+        multiply128(static_cast<quint64>(mixHash(hash)), static_cast<quint64>(bucketCount), low, high);
+        return static_cast<int>(high);
+    }
+    case HashMapBucketReducer::Modulo:
+        break;
+    }
+    return static_cast<int>(hash % static_cast<size_t>(bucketCount));
+}
+
+// Tracing policies for the typed backends. Steps are recorded as StepEvent
+// records (see hashmaptrace.h) and only formatted when displayed; with
+// NoStepTrace every step compiles away.
+struct NoStepTrace {
+    static constexpr bool enabled = false;
+
+    explicit NoStepTrace(StepLog * = nullptr) {}
+    bool active() const { return false; }
+    void setMuted(bool) {}
+    void record(const StepEvent &) {}
+    qint32 operand(const QVariant &) { return -1; }
+};
+
+// Appends events to a caller-owned log (no-op when it is null)
+class StepTrace {
+public:
+    static constexpr bool enabled = true;
+
+    explicit StepTrace(StepLog *log = nullptr) : log_(log) {}
+    bool active() const { return log_ != nullptr && !muted_; }
+
+    // Batch operations mute per-key steps; the caller records a summary
+    void setMuted(bool muted) { muted_ = muted; }
+
+    void record(const StepEvent &event) {
+        if (active()) log_->append(event);
+    }
+
+    qint32 operand(const QVariant &value) {
+        return active() ? log_->addOperand(value) : -1;
+    }
+
+private:
+    StepLog *log_;
+    bool muted_ = false;
+};
+
+// Step recording shared by the typed backends. Events carry plain integers;
+// keys and values are pooled as operands only while a log is attached.
+template <typename K, typename V, typename Tracer>
+class HashMapStepRecorder {
+protected:
+    using KeyTraits = HashMapTraits<K>;
+    using ValueTraits = HashMapTraits<V>;
+
+    // A new table counts as fully changed for whoever draws it
+    explicit HashMapStepRecorder(StepLog *log) : tracer_(log) { dirty_.markAll(); }
+
+    bool tracing() const { return tracer_.active(); }
+
+    // Base hash from KeyTraits, finished by the selected strategy
+    template <typename Q>
+    size_t keyHash(const Q &key) const { return hashStrategy_.apply(KeyTraits::hash(key)); }
+
+    // Keys ahead of the current one whose bucket a batch prefetches
+    static constexpr int BatchPrefetchDistance = 8;
+
+    // Shared loop of the batch operations. Every key is hashed before the
+    // first probe, then probe(i, hash) runs for each key while the bucket of
+    // the key BatchPrefetchDistance ahead is prefetched. Callers mute steps
+    // around the whole batch, presizing included.
+    template <typename Hash, typename Prefetch, typename Probe>
+    void runBatch(const K *keys, int count, Hash &&hash, Prefetch &&prefetch, Probe &&probe) {
+        std::vector<size_t> hashes(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            hashes[static_cast<size_t>(i)] = hash(keys[i]);
+        }
+        for (int i = 0; i < count; ++i) {
+            if (i + BatchPrefetchDistance < count) {
+                prefetch(hashes[static_cast<size_t>(i + BatchPrefetchDistance)]);
+            }
+            probe(i, hashes[static_cast<size_t>(i)]);
+        }
+    }
+
+    void muteSteps(bool muted) { tracer_.setMuted(muted); }
+
+    // Buckets written since takeDirtyBuckets() was last called. Tracked in
+    // traced builds only, the ones a view draws; untraced builds always
+    // report every bucket.
+    void markDirty(int bucket) {
+        if constexpr (Tracer::enabled) dirty_.mark(bucket);
+    }
+
+    void markAllDirty() {
+        if constexpr (Tracer::enabled) dirty_.markAll();
+    }
+
+    HashMapDirtySet takeDirtyBuckets() {
+        HashMapDirtySet taken;
+        if constexpr (Tracer::enabled) {
+            std::swap(taken, dirty_);
+        } else {
+            taken.markAll();
+        }
+        return taken;
+    }
+
+    void addStep(HashMapTrace::Op op, int bucket = -1, int result = 0, quint16 flags = 0, quint64 hash = 0) {
+        if constexpr (Tracer::enabled) {
+            StepEvent event;
+            event.op = op;
+            event.flags = flags;
+            event.bucket = bucket;
+            event.result = result;
+            event.hash = hash;
+            tracer_.record(event);
+        }
+    }
+
+    template <typename T>
+    qint32 operand(const T &value) {
+        if constexpr (Tracer::enabled) {
+            if (tracing()) return tracer_.operand(QVariant::fromValue(value));
+        }
+        return -1;
+    }
+
+    // Steps whose operands are a key/value pair (moves and shifts)
+    void addEntryStep(HashMapTrace::Op op, const K &key, const V &value, int bucket, quint16 flags = 0, quint64 extra = 0) {
+        if constexpr (Tracer::enabled) {
+            if (!tracing()) return;
+            StepEvent event;
+            event.op = op;
+            event.flags = flags;
+            event.bucket = bucket;
+            event.key = operand(key);
+            event.result = operand(value);
+            event.hash = extra;
+            tracer_.record(event);
+        }
+    }
+
+    void addValueStep(HashMapTrace::Op op, const V &value, qint32 second = 0) {
+        if constexpr (Tracer::enabled) {
+            if (!tracing()) return;
+            StepEvent event;
+            event.op = op;
+            event.key = operand(value);
+            event.result = second;
+            tracer_.record(event);
+        }
+    }
+
+    void addUpdateStep(const V &oldValue, const V &newValue) {
+        if constexpr (Tracer::enabled) {
+            if (!tracing()) return;
+            addValueStep(HashMapTrace::UpdateValue, oldValue, operand(newValue));
+        }
+    }
+
+    void addGrowStep(float projected, float limit, int newCount, quint16 flags) {
+        if constexpr (Tracer::enabled) {
+            if (!tracing()) return;
+            StepEvent event;
+            event.op = HashMapTrace::Grow;
+            event.flags = flags;
+            event.bucket = newCount;
+            event.key = tracer_.operand(QVariant(projected));
+            event.result = tracer_.operand(QVariant(limit));
+            tracer_.record(event);
+        }
+    }
+
+    // Pools the probe key once; later compare steps refer to it by handle
+    template <typename Q>
+    void addKeyHashStep(const Q &key, size_t hash, quint16 flags) {
+        if constexpr (Tracer::enabled) {
+            if (!tracing()) return;
+            probeKey_ = operand(ownedKey<K>(key));
+            StepEvent event;
+            event.op = HashMapTrace::ComputeHash;
+            event.flags = flags;
+            event.key = probeKey_;
+            event.hash = hash;
+            tracer_.record(event);
+        }
+    }
+
+    template <typename Q>
+    void addHashSteps(const Q &key, size_t hash, int bucketCount, int index,
+                      HashMapBucketReducer reducer = HashMapBucketReducer::Modulo) {
+        quint16 flags = KeyTraits::numeric ? HashMapTrace::Numeric : 0;
+        addKeyHashStep(key, hash, flags);
+        if (reducer == HashMapBucketReducer::Mask) flags |= HashMapTrace::MaskReduce;
+        if (reducer == HashMapBucketReducer::FastRange) flags |= HashMapTrace::FastRangeReduce;
+        addStep(HashMapTrace::ReduceIndex, index, bucketCount, flags, reducedHash(hash, reducer));
+    }
+
+    // hashMatch = false records a compare that the stored hash rejected
+    // without looking at the keys
+    void addCompareStep(const K &storedKey, bool match, bool hashMatch = true) {
+        if constexpr (Tracer::enabled) {
+            if (!tracing()) return;
+            StepEvent event;
+            event.op = HashMapTrace::Compare;
+            event.flags = match ? HashMapTrace::Match : (hashMatch ? 0 : HashMapTrace::HashReject);
+            event.key = operand(storedKey);
+            event.result = probeKey_;
+            tracer_.record(event);
+        }
+    }
+
+    Tracer tracer_;
+    qint32 probeKey_ = -1;
+    HashStrategy hashStrategy_;
+    HashMapDirtySet dirty_;
+};
+
+// Separate-chaining hash map over concrete key/value types.
+// Keys are hashed and compared directly, so no QVariant dispatch happens per node.
+// Tracer selects whether steps are recorded (StepTrace) or compiled out (NoStepTrace).
+// Growth can optionally be incremental: the old bucket vector is kept beside
+// the new one and every later operation migrates a bounded number of old
+// buckets, so no single insert pays for moving the whole table.
+// Chain nodes come from a slab pool: erased nodes are reused, clear() frees
+// the slabs wholesale, and resizing relinks nodes instead of reallocating.
+template <typename K, typename V, typename Tracer = StepTrace>
+class ChainedHashMap : private HashMapStepRecorder<K, V, Tracer> {
+    using Recorder = HashMapStepRecorder<K, V, Tracer>;
+    using typename Recorder::KeyTraits;
+    using typename Recorder::ValueTraits;
+    using Recorder::addStep;
+    using Recorder::addEntryStep;
+    using Recorder::addValueStep;
+    using Recorder::addUpdateStep;
+    using Recorder::addGrowStep;
+    using Recorder::addHashSteps;
+    using Recorder::addCompareStep;
+    using Recorder::runBatch;
+    using Recorder::muteSteps;
+    using Recorder::markDirty;
+    using Recorder::markAllDirty;
+    using Recorder::keyHash;
+    using Recorder::hashStrategy_;
+
+public:
+    using KeyType = K;
+    using ValueType = V;
+    using Recorder::takeDirtyBuckets;
+
+    static constexpr bool supportsIncrementalRehash = true;
+    static constexpr bool tracksKickChains = false;
+
+    explicit ChainedHashMap(int initialBucketCount = 16, const HashMapGrowthPolicy &policy = {},
+                            StepLog *steps = nullptr)
+        : Recorder(steps),
+        buckets_(static_cast<size_t>(policy.sanitized().roundedCount(initialBucketCount))),
+        policy_(policy.sanitized()),
+        chainStats_(bucketCount()) {}
+
+    ChainedHashMap(const ChainedHashMap &) = delete;
+    ChainedHashMap &operator=(const ChainedHashMap &) = delete;
+
+    ~ChainedHashMap() { destroyNodes(); }
+
+    // Insert without overwriting; returns true if a new key was added
+    bool insert(const K &key, const V &value) {
+        migrateStep();
+        maybeGrow();
+        return emplaceOrAssign(key, value, keyHash(key), /*assignIfExists=*/false);
+    }
+
+    // Insert or overwrite; returns true if a new key was added
+    bool put(const K &key, const V &value) {
+        migrateStep();
+        maybeGrow();
+        return emplaceOrAssign(key, value, keyHash(key), /*assignIfExists=*/true);
+    }
+
+    // Bulk insert (or put, with assignIfExists) of count pairs. Any pending
+    // migration is finished and the table presized once, so no resize
+    // happens mid-batch; per-key steps are not recorded. Returns the
+    // number of new keys.
+    int insertBatch(const K *keys, const V *values, int count, bool assignIfExists) {
+        if (count <= 0) return 0;
+        int added = 0;
+        muteSteps(true);
+        migrateBuckets(oldBucketCount());
+        reserve(numElements_ + count);
+        runBatch(keys, count, [this](const K &key) { return keyHash(key); },
+                 [this](size_t hash) { prefetchBucket(hash); },
+                 [&](int i, size_t hash) {
+                     maybeGrow();
+                     if (emplaceOrAssign(keys[i], values[i], hash, assignIfExists)) ++added;
+                 });
+        muteSteps(false);
+        return added;
+    }
+
+    // Bulk lookup: out[i] receives the value stored for keys[i], or nullptr
+    void findBatch(const K *keys, int count, const V **out) {
+        if (count <= 0) return;
+        muteSteps(true);
+        migrateBuckets(oldBucketCount());
+        runBatch(keys, count, [this](const K &key) { return keyHash(key); },
+                 [this](size_t hash) { prefetchBucket(hash); },
+                 [&](int i, size_t hash) { out[i] = findHashed(keys[i], hash); });
+        muteSteps(false);
+    }
+
+    // Returns a pointer to the stored value, or nullptr if absent. Q is K or
+    // any type KeyTraits can hash and K compares equal to (QStringView).
+    template <typename Q>
+    const V *find(const Q &key) {
+        migrateStep();
+        if (buckets_.empty()) {
+            addStep(HashMapTrace::EmptyTable);
+            return nullptr;
+        }
+
+        return findHashed(key, keyHash(key));
+    }
+
+    template <typename Q>
+    bool erase(const Q &key) {
+        migrateStep();
+        if (buckets_.empty()) {
+            addStep(HashMapTrace::EmptyTable, -1, 0, HashMapTrace::ForErase);
+            return false;
+        }
+
+        const size_t hash = keyHash(key);
+        const int index = indexForHash(hash, bucketCount());
+        addHashSteps(key, hash, bucketCount(), index, policy_.reducer);
+        addStep(HashMapTrace::Visit, index);
+
+        bool erased = eraseFromChain(buckets_[static_cast<size_t>(index)], key, hash);
+        if (erased) chainStats_.removed(index);
+        const int oldIndex = pendingOldIndex(hash);
+        if (!erased && oldIndex >= 0) {
+            addStep(HashMapTrace::Visit, oldIndex, 0, HashMapTrace::OldTable);
+            erased = eraseFromChain(oldBuckets_[static_cast<size_t>(oldIndex)], key, hash);
+            if (erased) oldChainStats_.removed(oldIndex);
+        }
+        if (!erased) {
+            addStep(HashMapTrace::ChainEnd, -1, 0, HashMapTrace::ForErase);
+            return false;
+        }
+        // Pending old entries are drawn under their new bucket too
+        markDirty(index);
+        maybeShrink();
+        return true;
+    }
+
+    void clear() {
+        destroyNodes();
+        std::fill(buckets_.begin(), buckets_.end(), nullptr);
+        oldBuckets_.clear();
+        migrated_ = 0;
+        numElements_ = 0;
+        pool_.release();
+        chainStats_.reset(bucketCount());
+        oldChainStats_.reset(0);
+        markAllDirty();
+    }
+
+    // Rehashes everything now, finishing any incremental rehash first
+    void rehash(int newBucketCount) {
+        newBucketCount = policy_.roundedCount(newBucketCount);
+        migrateBuckets(oldBucketCount());
+        addStep(HashMapTrace::Rehash, newBucketCount);
+        markAllDirty();
+
+        std::vector<Node *> newBuckets(static_cast<size_t>(newBucketCount), nullptr);
+        HashMapChainStats newStats(newBucketCount);
+        for (Node *head : buckets_) {
+            relinkChain(head, newBuckets, newStats);
+        }
+        buckets_.swap(newBuckets);
+        chainStats_ = std::move(newStats);
+    }
+
+    // Grows the table now so that n entries fit under the max load factor
+    void reserve(int n) {
+        const int needed = policy_.bucketsFor(n);
+        if (needed > bucketCount()) rehash(needed);
+    }
+
+    // A new reducer changes every bucket index, so the table is rebuilt
+    void setGrowthPolicy(const HashMapGrowthPolicy &policy) {
+        const bool reindex = policy.reducer != policy_.reducer;
+        if (reindex) migrateBuckets(oldBucketCount());
+        policy_ = policy.sanitized();
+        if (reindex) rehash(bucketCount());
+    }
+
+    // Old buckets migrated per operation while resizing; 0 resizes in one step
+    void setIncrementalRehash(int bucketsPerStep) {
+        bucketsPerStep_ = std::max(0, bucketsPerStep);
+        if (bucketsPerStep_ == 0) migrateBuckets(oldBucketCount());
+    }
+
+    bool isRehashing() const { return !oldBuckets_.empty(); }
+
+    int size() const { return numElements_; }
+    int bucketCount() const { return static_cast<int>(buckets_.size()); }
+
+    float loadFactor() const {
+        if (buckets_.empty()) return 0.0f;
+        return static_cast<float>(numElements_) / static_cast<float>(buckets_.size());
+    }
+
+    size_t hashOf(const K &key) const { return keyHash(key); }
+
+    int indexFor(const K &key, int bucketCount) const {
+        return indexForHash(keyHash(key), bucketCount);
+    }
+
+    // Switching the hash function recomputes every stored hash and
+    // rebuilds the chains at the current size
+    void setHashStrategy(const HashStrategy &strategy) {
+        if (strategy == hashStrategy_) return;
+        migrateBuckets(oldBucketCount());
+        hashStrategy_ = strategy;
+        for (Node *head : buckets_) {
+            for (Node *node = head; node; node = node->next) node->hash = keyHash(node->key);
+        }
+        if (numElements_ > 0) rehash(bucketCount());
+    }
+
+    // Entries per home bucket; for chaining that is just the chain lengths
+    QVector<int> homeBucketCounts() const { return bucketSizes(); }
+
+    // Sizes are reported against the new table, counting entries that are
+    // still waiting in the old one under the bucket they will move to. The
+    // lengths are tracked, so only those pending entries are walked.
+    QVector<int> bucketSizes() const {
+        QVector<int> sizes = chainStats_.lengths();
+        for (int old = migrated_; old < oldBucketCount(); ++old) {
+            for (const Node *node = oldBuckets_[static_cast<size_t>(old)]; node; node = node->next) {
+                ++sizes[indexForHash(node->hash, bucketCount())];
+            }
+        }
+        return sizes;
+    }
+
+    // Buckets per chain length over every chain a lookup may walk: the new
+    // table plus the old buckets still waiting to migrate
+    QVector<int> chainLengthHistogram() const {
+        QVector<int> histogram = chainStats_.histogram();
+        if (!isRehashing()) return histogram;
+
+        const QVector<int> pending = oldChainStats_.histogram();
+        if (pending.size() > histogram.size()) histogram.resize(pending.size());
+        for (int i = 0; i < pending.size(); ++i) histogram[i] += pending[i];
+        histogram[0] -= migrated_;  // migrated old buckets are empty and no longer probed
+        return histogram;
+    }
+
+    int maxChainLength() const { return std::max(chainStats_.maxLength(), oldChainStats_.maxLength()); }
+
+    // Visit every entry of one bucket in chain order, then the entries of the
+    // old table that will migrate into it. Stops after maxEntries (-1 for
+    // no cap) and returns the number visited.
+    template <typename Fn>
+    int forEachInBucket(int index, Fn &&fn, int maxEntries = -1) const {
+        int visited = 0;
+        for (const Node *node = buckets_[static_cast<size_t>(index)]; node; node = node->next) {
+            if (visited == maxEntries) return visited;
+            fn(node->key, node->value);
+            ++visited;
+        }
+        if (!isRehashing()) return visited;
+
+        // When the table exactly doubled, new bucket i only receives entries
+        // from old bucket i % oldCount (i / 2 under fastrange); otherwise
+        // any pending bucket may
+        const bool doubled = bucketCount() == 2 * oldBucketCount();
+        const int source = policy_.reducer == HashMapBucketReducer::FastRange ? index / 2 : index % oldBucketCount();
+        const int first = doubled ? source : migrated_;
+        const int last = doubled ? first + 1 : oldBucketCount();
+        for (int old = std::max(first, migrated_); old < last; ++old) {
+            for (const Node *node = oldBuckets_[static_cast<size_t>(old)]; node; node = node->next) {
+                if (indexForHash(node->hash, bucketCount()) != index) continue;
+                if (visited == maxEntries) return visited;
+                fn(node->key, node->value);
+                ++visited;
+            }
+        }
+        return visited;
+    }
+
+    // Entries forEachInBucket would visit; tracked unless a migration is pending
+    int bucketEntryCount(int index) const {
+        if (!isRehashing()) return chainStats_.length(index);
+        return forEachInBucket(index, [](const K &, const V &) {});
+    }
+
+private:
+    // The full hash is kept so rehashing never rehashes keys and chain walks
+    // can reject most non-matching nodes without comparing keys
+    struct Node {
+        K key;
+        V value;
+        size_t hash;
+        Node *next;
+    };
+
+    // Each bucket is the head of an intrusive singly linked chain
+    std::vector<Node *> buckets_;
+    int numElements_ = 0;
+    HashMapGrowthPolicy policy_;
+    HashMapNodePool<Node> pool_;
+    HashMapChainStats chainStats_;     // lengths of the chains in buckets_
+    HashMapChainStats oldChainStats_;  // lengths of the chains in oldBuckets_
+
+    // Incremental rehash state: old buckets below migrated_ are already empty
+    std::vector<Node *> oldBuckets_;
+    int migrated_ = 0;
+    int bucketsPerStep_ = 0;
+
+    int indexForHash(size_t hash, int bucketCount) const {
+        return reduceHash(hash, bucketCount, policy_.reducer);
+    }
+
+    void prefetchBucket(size_t hash) const {
+        prefetchForRead(&buckets_[static_cast<size_t>(indexForHash(hash, bucketCount()))]);
+    }
+
+    template <typename Q>
+    const V *findHashed(const Q &key, size_t hash) {
+        const int index = indexForHash(hash, bucketCount());
+        addHashSteps(key, hash, bucketCount(), index, policy_.reducer);
+        addStep(HashMapTrace::Visit, index, 0, HashMapTrace::Target);
+
+        const Node *node = findInChain(buckets_[static_cast<size_t>(index)], key, hash);
+        const int oldIndex = pendingOldIndex(hash);
+        if (!node && oldIndex >= 0) {
+            addStep(HashMapTrace::Visit, oldIndex, 0, HashMapTrace::Target | HashMapTrace::OldTable);
+            node = findInChain(oldBuckets_[static_cast<size_t>(oldIndex)], key, hash);
+        }
+        if (node) {
+            addValueStep(HashMapTrace::Found, node->value);
+            return &node->value;
+        }
+        addStep(HashMapTrace::ChainEnd);
+        return nullptr;
+    }
+
+    int oldBucketCount() const { return static_cast<int>(oldBuckets_.size()); }
+
+    // Old bucket that may still hold the key, or -1 once it has migrated
+    int pendingOldIndex(size_t hash) const {
+        if (!isRehashing()) return -1;
+        const int old = indexForHash(hash, oldBucketCount());
+        return old >= migrated_ ? old : -1;
+    }
+
+    // Keys are only compared when the stored hash matches
+    template <typename Q>
+    Node *findInChain(Node *head, const Q &key, size_t hash) {
+        for (Node *node = head; node; node = node->next) {
+            const bool hashMatch = node->hash == hash;
+            const bool match = hashMatch && node->key == key;
+            addCompareStep(node->key, match, hashMatch);
+            if (match) return node;
+            addStep(HashMapTrace::TraverseChain);
+        }
+        return nullptr;
+    }
+
+    // Unlinks the matching node and returns it to the pool
+    template <typename Q>
+    bool eraseFromChain(Node *&head, const Q &key, size_t hash) {
+        for (Node **link = &head; *link; link = &(*link)->next) {
+            Node *node = *link;
+            const bool hashMatch = node->hash == hash;
+            const bool match = hashMatch && node->key == key;
+            addCompareStep(node->key, match, hashMatch);
+            if (match) {
+                *link = node->next;
+                pool_.destroy(node);
+                --numElements_;
+                addStep(HashMapTrace::Erased, bucketCount(), numElements_);
+                return true;
+            }
+            addStep(HashMapTrace::TraverseChain);
+        }
+        return false;
+    }
+
+    // Resizes through an incremental migration when one is configured
+    void resizeTo(int newBucketCount) {
+        if (bucketsPerStep_ > 0) {
+            beginIncrementalRehash(newBucketCount);
+        } else {
+            rehash(newBucketCount);
+        }
+    }
+
+    // Moves every node of one chain onto the front of its chain in target;
+    // nodes are relinked in place, never copied or reallocated
+    void relinkChain(Node *head, std::vector<Node *> &target, HashMapChainStats &targetStats) {
+        const int targetCount = static_cast<int>(target.size());
+        while (head) {
+            Node *node = head;
+            head = node->next;
+            const int newIndex = indexForHash(node->hash, targetCount);
+            addEntryStep(HashMapTrace::Move, node->key, node->value, newIndex);
+            node->next = target[static_cast<size_t>(newIndex)];
+            target[static_cast<size_t>(newIndex)] = node;
+            targetStats.added(newIndex);
+            markDirty(newIndex);
+        }
+    }
+
+    // Runs destructors for every node still linked; trivially destructible
+    // entries skip the walk since releasing the slabs is enough
+    void destroyNodes() {
+        if constexpr (!std::is_trivially_destructible_v<Node>) {
+            const auto destroyChains = [this](std::vector<Node *> &heads, int first) {
+                for (size_t i = static_cast<size_t>(first); i < heads.size(); ++i) {
+                    for (Node *node = heads[i]; node;) {
+                        Node *next = node->next;
+                        pool_.destroy(node);
+                        node = next;
+                    }
+                    heads[i] = nullptr;
+                }
+            };
+            destroyChains(buckets_, 0);
+            destroyChains(oldBuckets_, migrated_);
+        }
+    }
+
+    void beginIncrementalRehash(int newBucketCount) {
+        addStep(HashMapTrace::Rehash, newBucketCount, 0, HashMapTrace::Incremental);
+        markAllDirty();
+        std::vector<Node *> newBuckets(static_cast<size_t>(newBucketCount), nullptr);
+        oldBuckets_.swap(buckets_);
+        buckets_.swap(newBuckets);
+        oldChainStats_ = std::move(chainStats_);
+        chainStats_.reset(newBucketCount);
+        migrated_ = 0;
+    }
+
+    void migrateStep() {
+        if (isRehashing()) migrateBuckets(bucketsPerStep_);
+    }
+
+    // Moves up to count old buckets into the new table
+    void migrateBuckets(int count) {
+        if (!isRehashing() || count <= 0) return;
+
+        const int first = migrated_;
+        const int last = std::min(oldBucketCount(), migrated_ + count);
+        for (; migrated_ < last; ++migrated_) {
+            Node *&head = oldBuckets_[static_cast<size_t>(migrated_)];
+            relinkChain(head, buckets_, chainStats_);
+            head = nullptr;
+            oldChainStats_.emptied(migrated_);
+        }
+        addStep(HashMapTrace::Migrate, first, oldBucketCount() - migrated_, 0, static_cast<quint64>(last - 1));
+
+        if (migrated_ == oldBucketCount()) {
+            std::vector<Node *>().swap(oldBuckets_);
+            oldChainStats_.reset(0);
+            migrated_ = 0;
+        }
+    }
+
+    void maybeGrow() {
+        // A pending migration finishes before the next resize starts
+        if (isRehashing()) return;
+
+        const float projected = (static_cast<float>(numElements_) + 1.0f)
+                                / static_cast<float>(buckets_.empty() ? 1 : buckets_.size());
+        if (projected > policy_.maxLoadFactor) {
+            const int newCount = policy_.grownCount(bucketCount());
+            addGrowStep(projected, policy_.maxLoadFactor, newCount, 0);
+            resizeTo(newCount);
+        }
+    }
+
+    void maybeShrink() {
+        if (isRehashing() || !policy_.shouldShrink(numElements_, bucketCount())) return;
+
+        const int newCount = policy_.shrunkCount(numElements_);
+        if (newCount >= bucketCount()) return;
+        addGrowStep(loadFactor(), policy_.minLoadFactor, newCount, HashMapTrace::Shrink);
+        resizeTo(newCount);
+    }
+
+    bool emplaceOrAssign(const K &key, const V &value, size_t hash, bool assignIfExists) {
+        const int index = indexForHash(hash, bucketCount());
+        addHashSteps(key, hash, bucketCount(), index, policy_.reducer);
+        addStep(HashMapTrace::Visit, index);
+
+        Node *node = findInChain(buckets_[static_cast<size_t>(index)], key, hash);
+        const int oldIndex = pendingOldIndex(hash);
+        if (!node && oldIndex >= 0) {
+            addStep(HashMapTrace::Visit, oldIndex, 0, HashMapTrace::OldTable);
+            node = findInChain(oldBuckets_[static_cast<size_t>(oldIndex)], key, hash);
+        }
+        if (node) {
+            if (assignIfExists) {
+                addUpdateStep(node->value, value);
+                node->value = value;
+                markDirty(index);
+            } else {
+                addStep(HashMapTrace::Duplicate);
+            }
+            return false; // not a new insertion
+        }
+
+        addStep(HashMapTrace::AppendNode, index);
+        markDirty(index);
+        Node *&head = buckets_[static_cast<size_t>(index)];
+        head = pool_.create(Node{key, value, hash, head});
+        chainStats_.added(index);
+        ++numElements_;
+        addStep(HashMapTrace::NewSize, bucketCount(), numElements_);
+        return true;
+    }
+};
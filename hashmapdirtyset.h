@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+// Buckets whose visible contents changed since the owner last collected
+// them, so a view can redraw only those. A handful of indices is tracked
+// exactly; past MaxTracked, or after a resize, clear or rehash, the set
+// degrades to "every bucket" and the view redraws in full. Marking is O(1)
+// amortized and never allocates.
+class HashMapDirtySet {
+public:
+    static constexpr int MaxTracked = 32;
+
+    void mark(int bucket) {
+        if (all_) return;
+        const auto end = buckets_.begin() + count_;
+        if (std::find(buckets_.begin(), end, bucket) != end) return;
+        if (count_ == MaxTracked) {
+            markAll();
+            return;
+        }
+        buckets_[static_cast<size_t>(count_++)] = bucket;
+    }
+
+    void markAll() {
+        all_ = true;
+        count_ = 0;
+    }
+
+    bool all() const { return all_; }
+    bool isEmpty() const { return !all_ && count_ == 0; }
+
+    bool contains(int bucket) const {
+        const auto end = buckets_.begin() + count_;
+        return all_ || std::find(buckets_.begin(), end, bucket) != end;
+    }
+
+    // The tracked indices; empty when all() is set
+    const int *begin() const { return buckets_.data(); }
+    const int *end() const { return buckets_.data() + count_; }
+
+private:
+    std::array<int, MaxTracked> buckets_{};
+    int count_ = 0;
+    bool all_ = false;
+};
@@ -0,0 +1,67 @@
+#include "hashmapheatmap.h"
+#include <QColor>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Empty buckets stay near the view background; longer chains run from the
+// visualizer's light purple to its dark text colour
+QRgb shadeFor(int length, int maxLength) {
+    if (length == 0) return qRgb(250, 248, 255);
+    const double t = maxLength > 1 ? static_cast<double>(length - 1) / (maxLength - 1) : 0.0;
+    const QColor light(200, 184, 255);
+    const QColor dark(45, 27, 105);
+    return qRgb(light.red() + qRound(t * (dark.red() - light.red())),
+                light.green() + qRound(t * (dark.green() - light.green())),
+                light.blue() + qRound(t * (dark.blue() - light.blue())));
+}
+
+} // namespace
+
+void HashMapHeatmap::render(const QVector<int> &sizes, double aspect) {
+    bucketCount_ = sizes.size();
+    bucketsPerPixel_ = std::max(1, (bucketCount_ + MaxPixels - 1) / MaxPixels);
+    maxLength_ = sizes.isEmpty() ? 0 : *std::max_element(sizes.begin(), sizes.end());
+
+    const int pixels = std::max(1, (bucketCount_ + bucketsPerPixel_ - 1) / bucketsPerPixel_);
+    const int columns = std::clamp(static_cast<int>(std::ceil(std::sqrt(pixels * aspect))), 1, pixels);
+    const int rows = (pixels + columns - 1) / columns;
+    if (image_.width() != columns || image_.height() != rows) {
+        image_ = QImage(columns, rows, QImage::Format_RGB32);
+    }
+
+    // Lengths are small, so every shade is worked out once up front
+    QVector<QRgb> palette(maxLength_ + 1);
+    for (int length = 0; length <= maxLength_; ++length) {
+        palette[length] = shadeFor(length, maxLength_);
+    }
+
+    // Pixels past the last bucket keep the view background
+    const QRgb outside = qRgb(240, 247, 255);
+    int bucket = 0;
+    for (int y = 0; y < rows; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image_.scanLine(y));
+        for (int x = 0; x < columns; ++x) {
+            if (bucket >= bucketCount_) {
+                line[x] = outside;
+                continue;
+            }
+            const int runEnd = std::min(bucketCount_, bucket + bucketsPerPixel_);
+            int length = sizes[bucket];
+            for (++bucket; bucket < runEnd; ++bucket) length = std::max(length, sizes[bucket]);
+            line[x] = palette[length];
+        }
+    }
+}
+
+int HashMapHeatmap::bucketAt(int x, int y) const {
+    if (x < 0 || y < 0 || x >= image_.width() || y >= image_.height()) return -1;
+    const qint64 bucket = (static_cast<qint64>(y) * image_.width() + x) * bucketsPerPixel_;
+    return bucket < bucketCount_ ? static_cast<int>(bucket) : -1;
+}
+
+QPoint HashMapHeatmap::pixelOf(int bucket) const {
+    const int pixel = bucket / bucketsPerPixel_;
+    return QPoint(pixel % std::max(1, image_.width()), pixel / std::max(1, image_.width()));
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QImage>
+#include <QRect>
+#include <QVector>
+
+// Zoomed-out view of a whole table: one pixel per bucket, row-major, shaded
+// by its bucketSizes() length (chain length, probe length or occupancy).
+// Tables past MaxPixels buckets fold each run of bucketsPerPixel() buckets
+// into one pixel holding the run's longest length.
+class HashMapHeatmap {
+public:
+    static constexpr int MaxPixels = 1024 * 1024;
+
+    // Rebuilds the image from every bucket length in a single pass; columns
+    // are chosen so the image is about aspect times as wide as it is tall
+    void render(const QVector<int> &sizes, double aspect);
+
+    const QImage &image() const { return image_; }
+    int bucketCount() const { return bucketCount_; }
+    int bucketsPerPixel() const { return bucketsPerPixel_; }
+    int maxLength() const { return maxLength_; }
+
+    // First bucket folded into the pixel at (x, y); -1 outside the table
+    int bucketAt(int x, int y) const;
+    // Pixel holding bucket
+    QPoint pixelOf(int bucket) const;
+
+private:
+    QImage image_;
+    int bucketCount_ = 0;
+    int bucketsPerPixel_ = 1;
+    int maxLength_ = 0;
+};
@@ -0,0 +1,260 @@
+#include "hashmaploader.h"
+#include <QFile>
+#include <QThread>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Bytes read from the file per call
+constexpr qint64 ReadBlock = qint64(1) << 20;
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Cuts the field starting at cursor off the line ending at end and moves
+// cursor past its delimiter; *delimited tells whether another field follows.
+// Quoted fields are unescaped into scratch. Returns false for an
+// unterminated quote.
+bool takeField(const char *&cursor, const char *end, char delimiter, QByteArray &scratch,
+               const char *&fieldBegin, const char *&fieldEnd, bool *delimited) {
+    while (cursor < end && *cursor != delimiter && isBlank(*cursor)) ++cursor;
+
+    if (cursor < end && *cursor == '"') {
+        scratch.clear();
+        ++cursor;
+        for (;;) {
+            if (cursor == end) return false;
+            if (*cursor == '"') {
+                if (cursor + 1 < end && cursor[1] == '"') {
+                    scratch.append('"');
+                    cursor += 2;
+                    continue;
+                }
+                ++cursor;
+                break;
+            }
+            scratch.append(*cursor++);
+        }
+        fieldBegin = scratch.constData();
+        fieldEnd = fieldBegin + scratch.size();
+        // Anything between the closing quote and the delimiter is dropped
+        while (cursor < end && *cursor != delimiter) ++cursor;
+    } else {
+        fieldBegin = cursor;
+        while (cursor < end && *cursor != delimiter) ++cursor;
+        fieldEnd = cursor;
+        while (fieldEnd > fieldBegin && isBlank(fieldEnd[-1])) --fieldEnd;
+    }
+
+    *delimited = cursor < end;
+    if (*delimited) ++cursor;
+    return true;
+}
+
+} // namespace
+
+HashMapFileLoader::HashMapFileLoader() = default;
+
+HashMapFileLoader::~HashMapFileLoader() {
+    stop();
+}
+
+bool HashMapFileLoader::start(const QString &path, const Options &options, QString *error) {
+    stop();
+
+    auto file = std::make_unique<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        if (error) *error = QString("Cannot open %1: %2").arg(path, file->errorString());
+        return false;
+    }
+
+    options_ = options;
+    options_.chunkRows = std::max(1, options_.chunkRows);
+    options_.maxQueuedChunks = std::max(1, options_.maxQueuedChunks);
+    file_ = std::move(file);
+    totalBytes_ = file_->size();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_.store(false);
+        error_.clear();
+    }
+    bytesRead_.store(0);
+    rowsParsed_.store(0);
+    rowsSkipped_.store(0);
+    finishedMs_.store(-1);
+    running_.store(true);
+    clock_.start();
+
+    thread_ = QThread::create([this] { run(); });
+    thread_->start();
+    return true;
+}
+
+void HashMapFileLoader::stop() {
+    {
+        // Set under the lock so a reader about to wait on a full queue sees it
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_.store(true);
+    }
+    queueSpace_.notify_all();
+    join();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.clear();
+}
+
+void HashMapFileLoader::join() {
+    if (!thread_) return;
+    thread_->wait();
+    delete thread_;
+    thread_ = nullptr;
+    file_.reset();
+}
+
+bool HashMapFileLoader::takeChunk(Chunk *chunk) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) return false;
+        *chunk = std::move(queue_.front());
+        queue_.pop_front();
+    }
+    queueSpace_.notify_one();
+    return true;
+}
+
+bool HashMapFileLoader::isDone() const {
+    if (running_.load()) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.empty();
+}
+
+qint64 HashMapFileLoader::elapsedMs() const {
+    const qint64 finished = finishedMs_.load();
+    if (finished >= 0) return finished;
+    return clock_.isValid() ? clock_.elapsed() : 0;
+}
+
+QString HashMapFileLoader::error() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+}
+
+QVariant HashMapFileLoader::convert(const char *begin, const char *end, HashMap::DataType type) {
+    const int length = static_cast<int>(end - begin);
+    bool ok = false;
+    switch (type) {
+    case HashMap::STRING:
+        return QString::fromUtf8(begin, length);
+    case HashMap::INTEGER: {
+        const int value = QByteArray::fromRawData(begin, length).toInt(&ok);
+        return ok ? QVariant(value) : QVariant();
+    }
+    case HashMap::DOUBLE: {
+        const double value = QByteArray::fromRawData(begin, length).toDouble(&ok);
+        return ok ? QVariant(value) : QVariant();
+    }
+    case HashMap::FLOAT: {
+        const float value = QByteArray::fromRawData(begin, length).toFloat(&ok);
+        return ok ? QVariant(value) : QVariant();
+    }
+    case HashMap::CHAR: {
+        // A UTF-8 sequence is at most four bytes
+        const QString text = QString::fromUtf8(begin, std::min(length, 4));
+        return text.isEmpty() ? QVariant() : QVariant(text.at(0));
+    }
+    }
+    return QVariant();
+}
+
+bool HashMapFileLoader::push(Chunk &chunk) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        queueSpace_.wait(lock, [this] {
+            return stopRequested_.load() || static_cast<int>(queue_.size()) < options_.maxQueuedChunks;
+        });
+        if (stopRequested_.load()) return false;
+        rowsParsed_.fetch_add(chunk.keys.size(), std::memory_order_relaxed);
+        queue_.push_back(std::move(chunk));
+    }
+    chunk = Chunk();
+    chunk.keys.reserve(options_.chunkRows);
+    chunk.values.reserve(options_.chunkRows);
+    return true;
+}
+
+void HashMapFileLoader::run() {
+    Chunk chunk;
+    chunk.keys.reserve(options_.chunkRows);
+    chunk.values.reserve(options_.chunkRows);
+    QByteArray keyScratch;
+    QByteArray valueScratch;
+    char delimiter = 0;  // picked from the first non-empty line
+    qint64 skipped = 0;
+    bool open = true;    // false once the queue refused a chunk
+
+    const auto parseLine = [&](const char *line, const char *end) {
+        if (end > line && end[-1] == '\r') --end;
+        if (line == end) return;
+        if (!delimiter) delimiter = std::memchr(line, '\t', end - line) ? '\t' : ',';
+
+        const char *cursor = line;
+        const char *keyBegin, *keyEnd, *valueBegin, *valueEnd;
+        bool delimited = false;
+        if (!takeField(cursor, end, delimiter, keyScratch, keyBegin, keyEnd, &delimited) || !delimited
+            || !takeField(cursor, end, delimiter, valueScratch, valueBegin, valueEnd, &delimited)
+            || keyBegin == keyEnd || valueBegin == valueEnd) {
+            ++skipped;
+            return;
+        }
+        QVariant key = convert(keyBegin, keyEnd, options_.keyType);
+        QVariant value = convert(valueBegin, valueEnd, options_.valueType);
+        if (!key.isValid() || !value.isValid()) {
+            ++skipped;
+            return;
+        }
+        chunk.keys.push_back(std::move(key));
+        chunk.values.push_back(std::move(value));
+        if (chunk.keys.size() == options_.chunkRows) {
+            rowsSkipped_.store(skipped, std::memory_order_relaxed);
+            open = push(chunk);
+        }
+    };
+
+    // Bytes after the last newline wait for the next block
+    QByteArray buffer;
+    while (open && !stopRequested_.load(std::memory_order_relaxed)) {
+        const QByteArray block = file_->read(ReadBlock);
+        if (block.isEmpty()) {
+            if (!file_->atEnd()) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                error_ = QString("Read from %1 failed: %2").arg(file_->fileName(), file_->errorString());
+            }
+            break;
+        }
+        bytesRead_.fetch_add(block.size(), std::memory_order_relaxed);
+        buffer.append(block);
+
+        const char *data = buffer.constData();
+        const char *end = data + buffer.size();
+        const char *line = data;
+        while (open) {
+            const char *newline = static_cast<const char *>(std::memchr(line, '\n', end - line));
+            if (!newline) break;
+            parseLine(line, newline);
+            line = newline + 1;
+        }
+        buffer.remove(0, static_cast<int>(line - data));
+    }
+
+    // The last line need not end in a newline
+    if (open && !stopRequested_.load() && !buffer.isEmpty()) {
+        parseLine(buffer.constData(), buffer.constData() + buffer.size());
+    }
+    rowsSkipped_.store(skipped, std::memory_order_relaxed);
+    if (open && !chunk.keys.isEmpty()) push(chunk);
+
+    finishedMs_.store(clock_.elapsed());
+    running_.store(false);
+}
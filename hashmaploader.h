@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include "hashmap.h"
+
+class QFile;
+class QThread;
+
+// Streams key/value pairs out of a CSV or TSV file on a worker thread. The
+// file is read in fixed-size blocks and tokenized in place; every row is
+// converted to the map's key and value types and handed over in chunks for
+// HashMap::putBatch. The visualizer polls for chunks on the GUI thread, so
+// the map itself is only ever touched there. A small bounded queue keeps the
+// reader from running far ahead of the inserts on very large files.
+//
+// Format: one pair per line, key in the first field and value in the
+// second; further fields are ignored. Fields are tab separated when the
+// first non-empty line contains a tab, comma separated otherwise. Fields may
+// be double-quoted with "" as an escaped quote, but not span lines. Rows
+// whose fields are missing or do not convert (a header, say) are skipped
+// and counted.
+class HashMapFileLoader {
+public:
+    struct Options {
+        HashMap::DataType keyType = HashMap::STRING;
+        HashMap::DataType valueType = HashMap::STRING;
+        int chunkRows = 16384;
+        int maxQueuedChunks = 8;
+    };
+
+    struct Chunk {
+        QVector<QVariant> keys;
+        QVector<QVariant> values;
+    };
+
+    HashMapFileLoader();
+    ~HashMapFileLoader();
+
+    HashMapFileLoader(const HashMapFileLoader &) = delete;
+    HashMapFileLoader &operator=(const HashMapFileLoader &) = delete;
+
+    // Opens path and starts the reader; a load still in flight is stopped
+    // first. Returns false with a reason in *error if the file cannot be read.
+    bool start(const QString &path, const Options &options, QString *error = nullptr);
+    // Asks the reader to finish early, waits for it and drops queued chunks
+    void stop();
+
+    // Moves the oldest parsed chunk into *chunk; false when none is ready
+    bool takeChunk(Chunk *chunk);
+
+    // The reader is still going
+    bool isRunning() const { return running_.load(); }
+    // The reader finished and every chunk was taken
+    bool isDone() const;
+
+    qint64 totalBytes() const { return totalBytes_; }
+    qint64 bytesRead() const { return bytesRead_.load(std::memory_order_relaxed); }
+    qint64 rowsParsed() const { return rowsParsed_.load(std::memory_order_relaxed); }
+    qint64 rowsSkipped() const { return rowsSkipped_.load(std::memory_order_relaxed); }
+    // Wall time of the current load, or of the last one once it finished
+    qint64 elapsedMs() const;
+    // Read error of the last load; empty when it reached the end of the file
+    QString error() const;
+
+    // Converts one field as the visualizer's inputs do; invalid on failure
+    static QVariant convert(const char *begin, const char *end, HashMap::DataType type);
+
+private:
+    Options options_;
+    std::unique_ptr<QFile> file_;
+    QThread *thread_ = nullptr;
+    qint64 totalBytes_ = 0;
+
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<bool> running_{false};
+    std::atomic<qint64> bytesRead_{0};
+    std::atomic<qint64> rowsParsed_{0};
+    std::atomic<qint64> rowsSkipped_{0};
+    std::atomic<qint64> finishedMs_{-1};
+    QElapsedTimer clock_;
+
+    // Everything below is guarded by mutex_
+    mutable std::mutex mutex_;
+    std::condition_variable queueSpace_;
+    std::deque<Chunk> queue_;
+    QString error_;
+
+    void run();
+    bool push(Chunk &chunk);
+    void join();
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Slab allocator for hash map chain nodes. Nodes are carved out of slabs
+// that double in size up to MaxSlabNodes, so a growing map makes few
+// allocations. An erased node goes on a free list and is handed out
+// again before any fresh slab space. release() drops every slab at once.
+// The pool never runs destructors on its own: callers destroy() nodes
+// they erase and must destroy any live nodes before release().
+template <typename Node>
+class HashMapNodePool {
+public:
+    static constexpr size_t FirstSlabNodes = 32;
+    static constexpr size_t MaxSlabNodes = 4096;
+
+    HashMapNodePool() = default;
+    HashMapNodePool(const HashMapNodePool &) = delete;
+    HashMapNodePool &operator=(const HashMapNodePool &) = delete;
+
+    template <typename... Args>
+    Node *create(Args &&...args) {
+        Slot *slot = freeList_;
+        if (slot) {
+            freeList_ = slot->nextFree;
+        } else {
+            if (used_ == slabNodes()) addSlab();
+            slot = &slabs_.back()[used_++];
+        }
+        ++live_;
+        return ::new (static_cast<void *>(slot->storage)) Node(std::forward<Args>(args)...);
+    }
+
+    // Destroys the node and keeps its storage for the next create()
+    void destroy(Node *node) {
+        node->~Node();
+        Slot *slot = reinterpret_cast<Slot *>(node);
+        slot->nextFree = freeList_;
+        freeList_ = slot;
+        --live_;
+    }
+
+    // Frees all slabs; every node handed out must already be destroyed
+    // (or be trivially destructible)
+    void release() {
+        slabs_.clear();
+        freeList_ = nullptr;
+        used_ = 0;
+        live_ = 0;
+    }
+
+    size_t liveNodes() const { return live_; }
+
+    size_t capacity() const {
+        size_t total = 0;
+        for (size_t i = 0; i < slabs_.size(); ++i) total += sizeForSlab(i);
+        return total;
+    }
+
+private:
+    union Slot {
+        Slot *nextFree;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    Slot *freeList_ = nullptr;
+    size_t used_ = 0;   // slots handed out from the newest slab
+    size_t live_ = 0;
+
+    static size_t sizeForSlab(size_t index) {
+        const size_t shift = std::min<size_t>(index, 7);  // 32 << 7 == MaxSlabNodes
+        return std::min(FirstSlabNodes << shift, MaxSlabNodes);
+    }
+
+    size_t slabNodes() const {
+        return slabs_.empty() ? 0 : sizeForSlab(slabs_.size() - 1);
+    }
+
+    void addSlab() {
+        slabs_.emplace_back(new Slot[sizeForSlab(slabs_.size())]);
+        used_ = 0;
+    }
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// How a full hash becomes a bucket index. Modulo works for any bucket
+// count but costs a 64-bit division per lookup and per moved entry. Mask
+// and FastRange avoid it; both read bits that std::hash leaves empty for
+// small integers, so they mix the hash first.
+enum class HashMapBucketReducer {
+    Modulo,    // hash % n
+    Mask,      // mix(hash) & (n - 1); bucket counts are kept at powers of two
+    FastRange  // high half of mix(hash) * n (Lemire), any bucket count
+};
+
+// Resize rules shared by every HashMap backend. The table grows by
+// growthFactor whenever an insert would push the load factor past
+// maxLoadFactor, and shrinks after an erase leaves it below minLoadFactor.
+// The two thresholds are kept far enough apart that a resize in one
+// direction never immediately triggers one in the other.
+struct HashMapGrowthPolicy {
+    float maxLoadFactor = 0.75f;  // grow when an insert would exceed this
+    float growthFactor = 2.0f;    // new bucket count = old count * growthFactor
+    float minLoadFactor = 0.2f;   // shrink when an erase drops below this; 0 never shrinks
+    int minBucketCount = 8;       // shrinking stops here
+    HashMapBucketReducer reducer = HashMapBucketReducer::Modulo;  // ignored by the Swiss table, which always masks
+
+    // Clamps the fields to workable values; backends pass the highest load
+    // factor their probing scheme tolerates
+    HashMapGrowthPolicy sanitized(float maxLoadCap = std::numeric_limits<float>::max()) const {
+        HashMapGrowthPolicy p = *this;
+        p.maxLoadFactor = std::min(std::max(p.maxLoadFactor, 0.1f), maxLoadCap);
+        p.growthFactor = std::max(p.growthFactor, 1.25f);
+        p.minBucketCount = p.roundedCount(p.minBucketCount);
+        // Right after a grow the load is maxLoadFactor / growthFactor; stay
+        // well below that so the next erase does not shrink straight back
+        p.minLoadFactor = std::min(std::max(p.minLoadFactor, 0.0f),
+                                   p.maxLoadFactor / (2.0f * p.growthFactor));
+        return p;
+    }
+
+    // Smallest usable bucket count >= n: the next power of two for Mask
+    int roundedCount(int n) const {
+        n = std::max(n, 1);
+        if (reducer != HashMapBucketReducer::Mask) return n;
+        int count = 1;
+        while (count < n) count *= 2;
+        return count;
+    }
+
+    // Bucket count that holds elements without exceeding maxLoadFactor
+    int bucketsFor(int elements) const {
+        return roundedCount(std::max(minBucketCount, static_cast<int>(std::ceil(elements / maxLoadFactor))));
+    }
+
+    int grownCount(int bucketCount) const {
+        return roundedCount(std::max(bucketCount + 1, static_cast<int>(std::ceil(bucketCount * growthFactor))));
+    }
+
+    // Shrink target: the load lands halfway between the two thresholds
+    int shrunkCount(int elements) const {
+        const float target = (minLoadFactor + maxLoadFactor) / 2.0f;
+        return roundedCount(std::max(minBucketCount, static_cast<int>(std::ceil(elements / target))));
+    }
+
+    bool shouldShrink(int elements, int bucketCount) const {
+        return minLoadFactor > 0.0f && bucketCount > minBucketCount
+               && static_cast<float>(elements) < minLoadFactor * static_cast<float>(bucketCount);
+    }
+};
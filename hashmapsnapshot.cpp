@@ -0,0 +1,205 @@
+#include "hashmapsnapshot.h"
+#include <cstring>
+#include <limits>
+
+namespace {
+
+void setError(QString *error, const QString &message) {
+    if (error) *error = message;
+}
+
+// Every string record of a column stays inside a blob of blobUnits code
+// units. The sum of two quint32 fields cannot overflow a quint64.
+bool stringsFit(const uchar *column, quint64 rows, quint64 blobUnits) {
+    const auto *records = reinterpret_cast<const SnapshotColumn<QString>::Stored *>(column);
+    for (quint64 row = 0; row < rows; ++row) {
+        if (quint64(records[row].offset) + records[row].length > blobUnits) return false;
+    }
+    return true;
+}
+
+// Bytes per key/value record in a column of the given type
+quint64 recordSize(quint8 type) {
+    switch (type) {
+    case HashMap::STRING: return sizeof(SnapshotColumn<QString>::Stored);
+    case HashMap::INTEGER: return sizeof(SnapshotColumn<int>::Stored);
+    case HashMap::DOUBLE: return sizeof(SnapshotColumn<double>::Stored);
+    case HashMap::FLOAT: return sizeof(SnapshotColumn<float>::Stored);
+    case HashMap::CHAR: return sizeof(SnapshotColumn<QChar>::Stored);
+    }
+    return 0;
+}
+
+// Checks that [offset, offset + bytes) is aligned and lies before limit
+bool sectionFits(quint64 offset, quint64 bytes, quint64 limit) {
+    return offset % 8 == 0 && offset <= limit && bytes <= limit - offset;
+}
+
+} // namespace
+
+bool HashMapSnapshotFormat::writeFile(const QString &path, const HashMapSnapshotHeader &header,
+                                      const std::vector<Section> &sections, QString *error) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        setError(error, QString("Cannot write %1: %2").arg(path, file.errorString()));
+        return false;
+    }
+
+    const char padding[8] = {};
+    quint64 position = 0;
+    const auto writeBytes = [&](const void *data, quint64 bytes) {
+        if (bytes == 0) return true;
+        if (file.write(static_cast<const char *>(data), static_cast<qint64>(bytes)) != static_cast<qint64>(bytes)) {
+            return false;
+        }
+        position += bytes;
+        return true;
+    };
+
+    bool ok = writeBytes(&header, sizeof(header));
+    for (const Section &section : sections) {
+        if (!ok) break;
+        ok = writeBytes(padding, section.offset - position) && writeBytes(section.data, section.bytes);
+    }
+    if (!ok) {
+        setError(error, QString("Write to %1 failed: %2").arg(path, file.errorString()));
+        file.remove();
+        return false;
+    }
+    return true;
+}
+
+bool HashMapSnapshot::open(const QString &path, QString *error) {
+    close();
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::ReadOnly)) {
+        setError(error, QString("Cannot open %1: %2").arg(path, file_.errorString()));
+        return false;
+    }
+
+    const quint64 fileSize = static_cast<quint64>(file_.size());
+    if (fileSize < sizeof(HashMapSnapshotHeader)) {
+        setError(error, QString("%1 is too small to be a snapshot").arg(path));
+        close();
+        return false;
+    }
+
+    const uchar *data = file_.map(0, static_cast<qint64>(fileSize));
+    if (!data) {
+        setError(error, QString("Cannot map %1: %2").arg(path, file_.errorString()));
+        close();
+        return false;
+    }
+
+    const auto *header = reinterpret_cast<const HashMapSnapshotHeader *>(data);
+    QString problem;
+    if (std::memcmp(header->magic, HashMapSnapshotFormat::Magic, sizeof(header->magic)) != 0) {
+        problem = "not a hash map snapshot";
+    } else if (header->byteOrder != HashMapSnapshotHeader::ByteOrderMark) {
+        problem = "written with a different byte order";
+    } else if (header->version > HashMapSnapshotHeader::CurrentVersion) {
+        problem = QString("format version %1 is newer than this build supports").arg(header->version);
+    } else if (header->version < 2 && header->hashKind == HashStrategy::MULTIPLY_SHIFT) {
+        problem = "stored multiply-shift hashes are from an older build; save it again";
+    } else if (header->hashCheck != HashMapSnapshotFormat::hashCheck()) {
+        problem = "written by a build with a different string hash";
+    } else if (recordSize(header->keyType) == 0 || recordSize(header->valueType) == 0
+               || header->hashKind > HashStrategy::MULTIPLY_SHIFT
+               || header->reducer != static_cast<quint8>(HashMapBucketReducer::Mask)) {
+        problem = "unknown column type, hash or bucket reducer";
+    } else if (header->bucketCount == 0 || (header->bucketCount & (header->bucketCount - 1)) != 0
+               || header->entryCount > std::numeric_limits<qint32>::max()) {
+        problem = "invalid bucket or entry count";
+    } else if (header->fileSize != fileSize
+               || !sectionFits(header->bucketOffset, (quint64(header->bucketCount) + 1) * sizeof(quint32), fileSize)
+               || !sectionFits(header->hashOffset, header->entryCount * sizeof(quint64), fileSize)
+               || !sectionFits(header->keyOffset, header->entryCount * recordSize(header->keyType), fileSize)
+               || !sectionFits(header->valueOffset, header->entryCount * recordSize(header->valueType), fileSize)
+               || !sectionFits(header->blobOffset, 0, fileSize)) {
+        problem = "truncated or sections out of bounds";
+    }
+
+    if (problem.isEmpty()) {
+        // The bucket index must be monotonic and cover every row
+        const auto *offsets = reinterpret_cast<const quint32 *>(data + header->bucketOffset);
+        bool monotonic = offsets[0] == 0;
+        for (quint32 b = 0; monotonic && b < header->bucketCount; ++b) monotonic = offsets[b] <= offsets[b + 1];
+        if (!monotonic || offsets[header->bucketCount] != header->entryCount) problem = "corrupt bucket index";
+    }
+
+    if (problem.isEmpty()) {
+        // Strings are read in place, so each one must lie inside the blob
+        const quint64 blobUnits = (fileSize - header->blobOffset) / sizeof(char16_t);
+        if ((header->keyType == HashMap::STRING
+             && !stringsFit(data + header->keyOffset, header->entryCount, blobUnits))
+            || (header->valueType == HashMap::STRING
+                && !stringsFit(data + header->valueOffset, header->entryCount, blobUnits))) {
+            problem = "string data out of bounds";
+        }
+    }
+
+    if (!problem.isEmpty()) {
+        setError(error, QString("Cannot load %1: %2").arg(path, problem));
+        close();
+        return false;
+    }
+
+    data_ = data;
+    header_ = header;
+    bucketOffsets_ = reinterpret_cast<const quint32 *>(data + header->bucketOffset);
+    hashes_ = reinterpret_cast<const quint64 *>(data + header->hashOffset);
+    blob_ = reinterpret_cast<const char16_t *>(data + header->blobOffset);
+    strategy_ = HashStrategy(static_cast<HashStrategy::Kind>(header->hashKind), header->hashSeed);
+    return true;
+}
+
+void HashMapSnapshot::close() {
+    if (data_) file_.unmap(const_cast<uchar *>(data_));
+    file_.close();
+    data_ = nullptr;
+    header_ = nullptr;
+    bucketOffsets_ = nullptr;
+    hashes_ = nullptr;
+    blob_ = nullptr;
+}
+
+std::optional<QVariant> HashMapSnapshot::get(const QVariant &key) const {
+    if (!isOpen()) return std::nullopt;
+
+    int row = -1;
+    switch (keyType()) {
+    case HashMap::STRING: {
+        const QString text = key.toString();
+        row = find<QString>(QStringView(text));
+        break;
+    }
+    case HashMap::INTEGER: row = find<int>(key.toInt()); break;
+    case HashMap::DOUBLE: row = find<double>(key.toDouble()); break;
+    case HashMap::FLOAT: row = find<float>(key.toFloat()); break;
+    case HashMap::CHAR: row = find<QChar>(key.toChar()); break;
+    }
+    if (row < 0) return std::nullopt;
+    return valueVariant(row);
+}
+
+QVariant HashMapSnapshot::keyVariant(int row) const {
+    switch (keyType()) {
+    case HashMap::STRING: return QVariant(keyAt<QString>(row).toString());
+    case HashMap::INTEGER: return QVariant(keyAt<int>(row));
+    case HashMap::DOUBLE: return QVariant(keyAt<double>(row));
+    case HashMap::FLOAT: return QVariant(keyAt<float>(row));
+    case HashMap::CHAR: return QVariant(keyAt<QChar>(row));
+    }
+    return QVariant();
+}
+
+QVariant HashMapSnapshot::valueVariant(int row) const {
+    switch (valueType()) {
+    case HashMap::STRING: return QVariant(valueAt<QString>(row).toString());
+    case HashMap::INTEGER: return QVariant(valueAt<int>(row));
+    case HashMap::DOUBLE: return QVariant(valueAt<double>(row));
+    case HashMap::FLOAT: return QVariant(valueAt<float>(row));
+    case HashMap::CHAR: return QVariant(valueAt<QChar>(row));
+    }
+    return QVariant();
+}
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QStringView>
+#include <QVariant>
+#include <optional>
+#include <vector>
+#include "hashmap.h"
+#include "hashmapcore.h"
+
+// Versioned binary snapshot of a HashMap's contents, designed to be opened
+// with QFile::map and queried in place. Layout (all sections 8-byte aligned,
+// native byte order):
+//
+//   HashMapSnapshotHeader
+//   bucket offsets  (bucketCount + 1) x quint32  rows of bucket b are
+//                                                [offset[b], offset[b + 1])
+//   hashes          entryCount x quint64          full strategy hash per row
+//   key column      entryCount x column record
+//   value column    entryCount x column record
+//   string blob     UTF-16 code units referenced by STRING column records
+//
+// Rows are grouped by bucket, so a lookup hashes the key, masks it to a
+// bucket and compares only that bucket's rows, rejecting on the stored hash
+// before looking at keys. Nothing is converted to QVariant on that path.
+struct HashMapSnapshotHeader {
+    // 2: multiply-shift hashes are the full 64-bit (a*x + b) >> 64
+    static constexpr quint32 CurrentVersion = 2;
+    static constexpr quint32 ByteOrderMark = 0x01020304u;
+
+    char magic[8];          // "HMSNAP\r\n"
+    quint32 version;
+    quint32 byteOrder;      // ByteOrderMark as written; anything else is foreign
+    quint8 keyType;         // HashMap::DataType
+    quint8 valueType;
+    quint8 hashKind;        // HashStrategy::Kind
+    quint8 reducer;         // HashMapBucketReducer of the bucket index
+    quint32 bucketCount;    // power of two
+    quint64 entryCount;
+    quint64 hashSeed;
+    quint64 hashCheck;      // base hash of a fixed string; differs across std::hash implementations
+    quint64 bucketOffset;
+    quint64 hashOffset;
+    quint64 keyOffset;
+    quint64 valueOffset;
+    quint64 blobOffset;
+    quint64 fileSize;
+};
+static_assert(sizeof(HashMapSnapshotHeader) == 96, "snapshot header layout is part of the file format");
+
+// On-disk encoding of one key or value type. Fixed-width types are stored
+// as is; strings store a (offset, length) reference into the blob. View is
+// what reads return: the value itself, or a QStringView into the mapping.
+template <typename T>
+struct SnapshotColumn;
+
+template <>
+struct SnapshotColumn<int> {
+    using Stored = qint32;
+    using View = int;
+    static constexpr HashMap::DataType type = HashMap::INTEGER;
+    static Stored store(int v, std::vector<char16_t> &) { return v; }
+    static View read(const Stored &s, const char16_t *) { return s; }
+    static int owned(View v) { return v; }
+};
+
+template <>
+struct SnapshotColumn<double> {
+    using Stored = double;
+    using View = double;
+    static constexpr HashMap::DataType type = HashMap::DOUBLE;
+    static Stored store(double v, std::vector<char16_t> &) { return v; }
+    static View read(const Stored &s, const char16_t *) { return s; }
+    static double owned(View v) { return v; }
+};
+
+template <>
+struct SnapshotColumn<float> {
+    using Stored = float;
+    using View = float;
+    static constexpr HashMap::DataType type = HashMap::FLOAT;
+    static Stored store(float v, std::vector<char16_t> &) { return v; }
+    static View read(const Stored &s, const char16_t *) { return s; }
+    static float owned(View v) { return v; }
+};
+
+template <>
+struct SnapshotColumn<QChar> {
+    using Stored = quint16;
+    using View = QChar;
+    static constexpr HashMap::DataType type = HashMap::CHAR;
+    static Stored store(QChar v, std::vector<char16_t> &) { return v.unicode(); }
+    static View read(const Stored &s, const char16_t *) { return QChar(s); }
+    static QChar owned(View v) { return v; }
+};
+
+template <>
+struct SnapshotColumn<QString> {
+    struct Stored {
+        quint32 offset;  // in UTF-16 code units from the start of the blob
+        quint32 length;
+    };
+    using View = QStringView;
+    static constexpr HashMap::DataType type = HashMap::STRING;
+    static Stored store(const QString &v, std::vector<char16_t> &blob) {
+        const Stored s{static_cast<quint32>(blob.size()), static_cast<quint32>(v.size())};
+        const char16_t *text = reinterpret_cast<const char16_t *>(v.utf16());
+        blob.insert(blob.end(), text, text + v.size());
+        return s;
+    }
+    static View read(const Stored &s, const char16_t *blob) { return QStringView(blob + s.offset, s.length); }
+    static QString owned(View v) { return v.toString(); }
+};
+
+// Read-only view of a snapshot file. open() maps the file and validates the
+// header and section bounds; lookups then read the mapping directly.
+class HashMapSnapshot {
+public:
+    HashMapSnapshot() = default;
+    ~HashMapSnapshot() { close(); }
+
+    HashMapSnapshot(const HashMapSnapshot &) = delete;
+    HashMapSnapshot &operator=(const HashMapSnapshot &) = delete;
+
+    // Returns false (with a reason in *error) for missing, truncated,
+    // foreign-endian or newer-version files
+    bool open(const QString &path, QString *error = nullptr);
+    void close();
+    bool isOpen() const { return header_ != nullptr; }
+
+    HashMap::DataType keyType() const { return static_cast<HashMap::DataType>(header_->keyType); }
+    HashMap::DataType valueType() const { return static_cast<HashMap::DataType>(header_->valueType); }
+    HashStrategy hashStrategy() const { return strategy_; }
+    int size() const { return isOpen() ? static_cast<int>(header_->entryCount) : 0; }
+    int bucketCount() const { return isOpen() ? static_cast<int>(header_->bucketCount) : 0; }
+
+    // Row holding key, or -1. K is the key column's type (QString, int,
+    // double, float or QChar); string keys are passed as QStringView.
+    template <typename K>
+    int find(typename SnapshotColumn<K>::View key) const {
+        if (!isOpen() || keyType() != SnapshotColumn<K>::type) return -1;
+        const size_t hash = strategy_.apply(HashMapTraits<K>::hash(key));
+        const int bucket = reduceHash(hash, bucketCount(), HashMapBucketReducer::Mask);
+        for (quint32 row = bucketOffsets_[bucket]; row < bucketOffsets_[bucket + 1]; ++row) {
+            if (hashes_[row] == static_cast<quint64>(hash) && keyAt<K>(static_cast<int>(row)) == key) {
+                return static_cast<int>(row);
+            }
+        }
+        return -1;
+    }
+
+    // Column reads; T must match keyType() / valueType()
+    template <typename T>
+    typename SnapshotColumn<T>::View keyAt(int row) const {
+        return SnapshotColumn<T>::read(column<T>(header_->keyOffset)[row], blob_);
+    }
+
+    template <typename T>
+    typename SnapshotColumn<T>::View valueAt(int row) const {
+        return SnapshotColumn<T>::read(column<T>(header_->valueOffset)[row], blob_);
+    }
+
+    // Type-erased convenience for the QVariant front end: converts the key
+    // once and only the value that is found
+    std::optional<QVariant> get(const QVariant &key) const;
+    QVariant keyVariant(int row) const;
+    QVariant valueVariant(int row) const;
+
+private:
+    QFile file_;
+    const uchar *data_ = nullptr;
+    const HashMapSnapshotHeader *header_ = nullptr;
+    const quint32 *bucketOffsets_ = nullptr;
+    const quint64 *hashes_ = nullptr;
+    const char16_t *blob_ = nullptr;
+    HashStrategy strategy_;
+
+    template <typename T>
+    const typename SnapshotColumn<T>::Stored *column(quint64 offset) const {
+        return reinterpret_cast<const typename SnapshotColumn<T>::Stored *>(data_ + offset);
+    }
+};
+
+// Builds a snapshot from entries visited in place; keys and values are
+// referenced, not copied, until write() returns
+template <typename K, typename V>
+class HashMapSnapshotWriter {
+public:
+    explicit HashMapSnapshotWriter(const HashStrategy &strategy) : strategy_(strategy) {}
+
+    void reserve(int n) { entries_.reserve(static_cast<size_t>(std::max(0, n))); }
+
+    void add(const K &key, const V &value) {
+        entries_.push_back(Entry{&key, &value, strategy_.apply(HashMapTraits<K>::hash(key))});
+    }
+
+    bool write(const QString &path, QString *error = nullptr) const;
+
+private:
+    struct Entry {
+        const K *key;
+        const V *value;
+        size_t hash;
+    };
+
+    HashStrategy strategy_;
+    std::vector<Entry> entries_;
+};
+
+namespace HashMapSnapshotFormat {
+
+constexpr char Magic[8] = {'H', 'M', 'S', 'N', 'A', 'P', '\r', '\n'};
+
+// Sections start on 8-byte boundaries so every column can be read in place
+inline quint64 aligned(quint64 offset) { return (offset + 7) & ~quint64(7); }
+
+inline quint64 hashCheck() { return static_cast<quint64>(HashMapTraits<QString>::hash(QStringView(u"HashMapSnapshot"))); }
+
+struct Section {
+    const void *data;
+    quint64 offset;
+    quint64 bytes;
+};
+
+// Writes the header and each section at its offset, zero-padding the gaps
+bool writeFile(const QString &path, const HashMapSnapshotHeader &header,
+               const std::vector<Section> &sections, QString *error);
+
+} // namespace HashMapSnapshotFormat
+
+template <typename K, typename V>
+bool HashMapSnapshotWriter<K, V>::write(const QString &path, QString *error) const {
+    const quint64 count = entries_.size();
+    quint32 buckets = 1;
+    while (buckets < count) buckets *= 2;  // load factor <= 1 under the mask
+
+    // Counting sort of the rows by bucket
+    std::vector<quint32> offsets(static_cast<size_t>(buckets) + 1, 0);
+    std::vector<int> bucketOf(entries_.size());
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        bucketOf[i] = reduceHash(entries_[i].hash, static_cast<int>(buckets), HashMapBucketReducer::Mask);
+        ++offsets[static_cast<size_t>(bucketOf[i]) + 1];
+    }
+    for (size_t b = 0; b < buckets; ++b) offsets[b + 1] += offsets[b];
+
+    std::vector<quint64> hashes(entries_.size());
+    std::vector<typename SnapshotColumn<K>::Stored> keys(entries_.size());
+    std::vector<typename SnapshotColumn<V>::Stored> values(entries_.size());
+    std::vector<char16_t> blob;
+    std::vector<quint32> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        const quint32 row = next[static_cast<size_t>(bucketOf[i])]++;
+        hashes[row] = static_cast<quint64>(entries_[i].hash);
+        keys[row] = SnapshotColumn<K>::store(*entries_[i].key, blob);
+        values[row] = SnapshotColumn<V>::store(*entries_[i].value, blob);
+    }
+
+    HashMapSnapshotHeader header{};
+    std::copy(std::begin(HashMapSnapshotFormat::Magic), std::end(HashMapSnapshotFormat::Magic), header.magic);
+    header.version = HashMapSnapshotHeader::CurrentVersion;
+    header.byteOrder = HashMapSnapshotHeader::ByteOrderMark;
+    header.keyType = static_cast<quint8>(SnapshotColumn<K>::type);
+    header.valueType = static_cast<quint8>(SnapshotColumn<V>::type);
+    header.hashKind = static_cast<quint8>(strategy_.kind());
+    header.reducer = static_cast<quint8>(HashMapBucketReducer::Mask);
+    header.bucketCount = buckets;
+    header.entryCount = count;
+    header.hashSeed = strategy_.seed();
+    header.hashCheck = HashMapSnapshotFormat::hashCheck();
+
+    using HashMapSnapshotFormat::aligned;
+    header.bucketOffset = aligned(sizeof(HashMapSnapshotHeader));
+    header.hashOffset = aligned(header.bucketOffset + offsets.size() * sizeof(quint32));
+    header.keyOffset = aligned(header.hashOffset + hashes.size() * sizeof(quint64));
+    header.valueOffset = aligned(header.keyOffset + keys.size() * sizeof(typename SnapshotColumn<K>::Stored));
+    header.blobOffset = aligned(header.valueOffset + values.size() * sizeof(typename SnapshotColumn<V>::Stored));
+    header.fileSize = header.blobOffset + blob.size() * sizeof(char16_t);
+
+    return HashMapSnapshotFormat::writeFile(path, header, {
+        {offsets.data(), header.bucketOffset, offsets.size() * sizeof(quint32)},
+        {hashes.data(), header.hashOffset, hashes.size() * sizeof(quint64)},
+        {keys.data(), header.keyOffset, keys.size() * sizeof(typename SnapshotColumn<K>::Stored)},
+        {values.data(), header.valueOffset, values.size() * sizeof(typename SnapshotColumn<V>::Stored)},
+        {blob.data(), header.blobOffset, blob.size() * sizeof(char16_t)},
+    }, error);
+}
@@ -0,0 +1,212 @@
+#include "hashmaptrace.h"
+#include "hashmap.h"
+
+namespace {
+
+QString operandText(const StepLog &log, qint32 handle) {
+    return handle < 0 ? QString() : HashMap::variantToDisplayString(log.operand(handle));
+}
+
+QString unit(const StepEvent &e) {
+    if (e.flags & HashMapTrace::OldTable) return QStringLiteral("old bucket");
+    return (e.flags & HashMapTrace::SlotUnit) ? QStringLiteral("slot") : QStringLiteral("bucket");
+}
+
+QString loadFactorText(int size, int bucketCount) {
+    const float loadFactor = bucketCount > 0 ? static_cast<float>(size) / static_cast<float>(bucketCount) : 0.0f;
+    return QString::number(loadFactor, 'f', 2);
+}
+
+} // namespace
+
+QString HashMapTrace::render(const StepEvent &e, const StepLog &log) {
+    const bool forErase = e.flags & ForErase;
+    switch (e.op) {
+    case BeginInsert: return QStringLiteral("➕ INSERT OPERATION");
+    case BeginPut: return QStringLiteral("➕ PUT OPERATION");
+    case BeginSearch: return QStringLiteral("🔍 SEARCH OPERATION");
+    case BeginDelete: return QStringLiteral("🗑️ DELETE OPERATION");
+    case TypeMismatch: return QStringLiteral("Type validation failed");
+    case Cleared: return QStringLiteral("Cleared all buckets");
+    case ComputeHash:
+        if (e.flags & Numeric) {
+            return QString("📊 Compute hash(%1) = %2").arg(operandText(log, e.key)).arg(e.hash);
+        }
+        return QString("📊 Compute hash for: \"%1\" = %2").arg(operandText(log, e.key)).arg(e.hash);
+    case ReduceIndex:
+        if (e.flags & MaskReduce) {
+            return QString("📐 Index = mix(hash) & (n − 1) = %1 & %2 = %3").arg(e.hash).arg(e.result - 1).arg(e.bucket);
+        }
+        if (e.flags & FastRangeReduce) {
+            return QString("📐 Index = ⌊mix(hash) × n / 2⁶⁴⌋ = ⌊%1 × %2 / 2⁶⁴⌋ = %3")
+                .arg(e.hash)
+                .arg(e.result)
+                .arg(e.bucket);
+        }
+        if (e.flags & Numeric) {
+            return QString("📐 Calculate: %2 % %1 = %3").arg(e.result).arg(e.hash).arg(e.bucket);
+        }
+        return QString("📐 Index = %2 % %1 = %3").arg(e.result).arg(e.hash).arg(e.bucket);
+    case SplitHash:
+        return QString("📐 Split: H1 = (hash >> 7) & %1 = group %2, H2 = hash & 0x7F = %3")
+            .arg(e.result)
+            .arg(e.bucket)
+            .arg(e.hash & 0x7F);
+    case Compare:
+        if (e.flags & HashReject) {
+            return QStringLiteral("Compare keys: %1 == %2 ? No (stored hash differs)")
+                .arg(operandText(log, e.key), operandText(log, e.result));
+        }
+        return QStringLiteral("Compare keys: %1 == %2 ? %3")
+            .arg(operandText(log, e.key), operandText(log, e.result),
+                 (e.flags & Match) ? QStringLiteral("Yes") : QStringLiteral("No"));
+    case Visit:
+        return QString("%1Visit %2 %3")
+            .arg((e.flags & Target) ? QStringLiteral("🎯 ") : QString(), unit(e))
+            .arg(e.bucket);
+    case TraverseChain: return QStringLiteral("Traverse next in chain");
+    case ProbeNext: return QStringLiteral("Probe next slot %1").arg(e.bucket);
+    case ProbeGroup: return QString("🎯 Probe group %1: %2 tag match(es)").arg(e.bucket).arg(e.result);
+    case GroupHasEmpty: return QStringLiteral("Group %1 has an EMPTY slot → not found").arg(e.bucket);
+    case ProbedAll: return QStringLiteral("Probed every group → not found");
+    case EmptyTable:
+        return forErase ? QStringLiteral("Table is empty → nothing to erase")
+                        : QStringLiteral("Table is empty → not found");
+    case ChainEnd:
+        return forErase ? QStringLiteral("Reached end of chain → key not found")
+                        : QStringLiteral("Reached end of chain → not found");
+    case ProbeEnd:
+        return forErase ? QStringLiteral("Reached empty or richer slot → key not found")
+                        : QStringLiteral("Reached empty or richer slot → not found");
+    case Found: return QStringLiteral("Found → return value %1").arg(operandText(log, e.key));
+    case UpdateValue:
+        return QStringLiteral("Key exists → update value: %1 → %2")
+            .arg(operandText(log, e.key), operandText(log, e.result));
+    case Duplicate: return QStringLiteral("Key exists → no insert (duplicate)");
+    case AppendNode: return QStringLiteral("Append new node to bucket %1").arg(e.bucket);
+    case PlaceEntry: return QStringLiteral("Place new entry in slot %1 (probe length %2)").arg(e.bucket).arg(e.result);
+    case PlaceTagged: return QStringLiteral("Place new entry in slot %1, control byte = %2").arg(e.bucket).arg(e.result);
+    case NewSize:
+        return QStringLiteral("New size = %1, load factor = %2").arg(e.result).arg(loadFactorText(e.result, e.bucket));
+    case Erased:
+        return QStringLiteral("Erased %1. New size = %2, load factor = %3")
+            .arg((e.flags & SlotUnit) ? QStringLiteral("entry") : QStringLiteral("node"))
+            .arg(e.result)
+            .arg(loadFactorText(e.result, e.bucket));
+    case ShiftBack:
+        return QStringLiteral("Shift (%1,%2) back: slot %3 → %4")
+            .arg(operandText(log, e.key), operandText(log, e.result))
+            .arg(e.bucket)
+            .arg(e.hash);
+    case MarkEmpty: return QStringLiteral("Mark slot %1 EMPTY").arg(e.bucket);
+    case MarkDeleted: return QStringLiteral("Mark slot %1 DELETED (group is full)").arg(e.bucket);
+    case Grow:
+        if (e.flags & Shrink) {
+            return QStringLiteral("Load factor %1 is below %2 → shrink to %3 %4s")
+                .arg(log.operand(e.key).toFloat(), 0, 'f', 2)
+                .arg(log.operand(e.result).toFloat(), 0, 'f', 2)
+                .arg(e.bucket)
+                .arg(unit(e));
+        }
+        return QStringLiteral("Load factor %1 exceeds %2 → rehash to %3 %4s")
+            .arg(log.operand(e.key).toFloat(), 0, 'f', 2)
+            .arg(log.operand(e.result).toFloat(), 0, 'f', 2)
+            .arg(e.bucket)
+            .arg(unit(e));
+    case Rehash:
+        if (e.flags & Incremental) {
+            return QStringLiteral("Incremental rehash to %1 buckets: old buckets migrate on later operations").arg(e.bucket);
+        }
+        if (e.result > 0) {
+            return QStringLiteral("Rehashing to %1 slots (%2 groups)").arg(e.bucket).arg(e.result);
+        }
+        return QStringLiteral("Rehashing to %1 %2s").arg(e.bucket).arg(unit(e));
+    case Move:
+        return QStringLiteral("Move (%1,%2) → %3 %4")
+            .arg(operandText(log, e.key), operandText(log, e.result), unit(e))
+            .arg(e.bucket);
+    case Migrate:
+        if (e.result == 0) {
+            return QStringLiteral("Migrated old buckets %1–%2 → rehash complete").arg(e.bucket).arg(e.hash);
+        }
+        return QStringLiteral("Migrated old buckets %1–%2 (%3 left)").arg(e.bucket).arg(e.hash).arg(e.result);
+    case BeginBatchInsert: return QStringLiteral("➕ BATCH INSERT OF %1 PAIRS").arg(e.result);
+    case BeginBatchPut: return QStringLiteral("➕ BATCH PUT OF %1 PAIRS").arg(e.result);
+    case BeginBatchSearch: return QStringLiteral("🔍 BATCH SEARCH OF %1 KEYS").arg(e.result);
+    case BatchSkipped: return QStringLiteral("Type validation failed for %1 pair(s) → skipped").arg(e.result);
+    case BatchResized:
+        return QStringLiteral("Presized once: %1 → %2 %3s").arg(e.result).arg(e.bucket).arg(unit(e));
+    case BatchInserted:
+        return QStringLiteral("Hashed all keys up front, prefetched buckets ahead → %1 new key(s). "
+                              "New size = %2, load factor = %3")
+            .arg(e.result)
+            .arg(e.hash)
+            .arg(loadFactorText(static_cast<int>(e.hash), e.bucket));
+    case BatchFound:
+        return QStringLiteral("Hashed all keys up front, prefetched buckets ahead → found %1 of %2")
+            .arg(e.result)
+            .arg(e.bucket);
+    case HashSwitch:
+        return QStringLiteral("🔀 HASH FUNCTION → %1: every key is rehashed in place")
+            .arg(HashStrategy::name(static_cast<HashStrategy::Kind>(e.result)));
+    case SnapshotLoaded:
+        return QStringLiteral("📂 Restored %1 entries from a snapshot in one batch → %2 %3s")
+            .arg(e.result)
+            .arg(e.bucket)
+            .arg(unit(e));
+    case ProbeAlternate: return QStringLiteral("Check the other table: slot %1").arg(e.bucket);
+    case ProbeStash: return QStringLiteral("Check the stash from slot %1 (%2 entries)").arg(e.bucket).arg(e.result);
+    case NotInCandidates:
+        return forErase ? QStringLiteral("Key is in neither candidate slot nor the stash → key not found")
+                        : QStringLiteral("Key is in neither candidate slot nor the stash → not found");
+    case Kick:
+        return QStringLiteral("🦶 Kick (%1,%2) out of slot %3 → its other slot %4")
+            .arg(operandText(log, e.key), operandText(log, e.result))
+            .arg(e.bucket)
+            .arg(e.hash);
+    case KickSettled: return QStringLiteral("Kick chain of %1 ended in empty slot %2").arg(e.result).arg(e.bucket);
+    case KickLimit:
+        return QStringLiteral("Kick chain reached %1 displacements and the stash is full → grow the tables").arg(e.result);
+    case Stashed:
+        return QStringLiteral("Kick chain too long → park entry in stash slot %1 (%2 stashed)").arg(e.bucket).arg(e.result);
+    case PlaceInTable: {
+        const QString where = e.result == 0 ? QStringLiteral("first table")
+                            : e.result == 1 ? QStringLiteral("second table") : QStringLiteral("stash");
+        return QStringLiteral("Place new entry in slot %1 (%2)").arg(e.bucket).arg(where);
+    }
+    default:
+        return QString();
+    }
+}
+
+StepCategory HashMapTrace::category(const StepEvent &e, const StepLog &log) {
+    switch (e.op) {
+    case StepLog::TextOp: {
+        const QString text = log.operand(e.key).toString();
+        if (text.contains("✅")) return StepCategory::Success;
+        if (text.contains("❌")) return StepCategory::Failure;
+        if (text.contains("🔍")) return StepCategory::Search;
+        if (text.contains("➕")) return StepCategory::Insert;
+        if (text.contains("🗑️")) return StepCategory::Delete;
+        if (text.contains("📊") || text.contains("🎯")) return StepCategory::Calculate;
+        return StepCategory::Plain;
+    }
+    case BeginInsert:
+    case BeginPut:
+    case BeginBatchInsert:
+    case BeginBatchPut:
+        return StepCategory::Insert;
+    case BeginSearch:
+    case BeginBatchSearch:
+        return StepCategory::Search;
+    case BeginDelete:
+        return StepCategory::Delete;
+    case ComputeHash:
+    case ProbeGroup:
+        return StepCategory::Calculate;
+    case Visit:
+        return (e.flags & Target) ? StepCategory::Calculate : StepCategory::Plain;
+    default:
+        return StepCategory::Plain;
+    }
+}
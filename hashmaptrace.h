@@ -0,0 +1,79 @@
+#pragma once
+
+#include "steplog.h"
+
+// Step opcodes emitted by HashMap and its typed backends, and the renderer
+// that turns them back into the visualizer's sentences.
+struct HashMapTrace {
+    enum Op : quint16 {
+        BeginInsert = StepLog::FirstUserOp,
+        BeginPut,
+        BeginSearch,
+        BeginDelete,
+        TypeMismatch,
+        Cleared,
+        ComputeHash,    // key, hash
+        ReduceIndex,    // hash, result = bucket count, bucket = index
+        SplitHash,      // hash, result = group mask, bucket = group
+        Compare,        // key = stored key, result = probe key handle
+        Visit,          // bucket
+        TraverseChain,
+        ProbeNext,      // bucket
+        ProbeGroup,     // bucket = group, result = tag matches
+        GroupHasEmpty,  // bucket = group
+        ProbedAll,
+        EmptyTable,
+        ChainEnd,
+        ProbeEnd,
+        Found,          // key = value handle
+        UpdateValue,    // key = old value handle, result = new value handle
+        Duplicate,
+        AppendNode,     // bucket
+        PlaceEntry,     // bucket, result = probe length
+        PlaceTagged,    // bucket, result = control byte
+        NewSize,        // result = size, bucket = bucket count
+        Erased,         // result = size, bucket = bucket count
+        ShiftBack,      // key, result = value handle, bucket = from, hash = to
+        MarkEmpty,      // bucket
+        MarkDeleted,    // bucket
+        Grow,           // key = load factor handle, result = limit handle, bucket = new count
+        Rehash,         // bucket = new count, result = groups (0 if not grouped)
+        Move,           // key, result = value handle, bucket = destination
+        Migrate,        // bucket = first old bucket, hash = last, result = old buckets left
+        BeginBatchInsert,  // result = pairs
+        BeginBatchPut,     // result = pairs
+        BeginBatchSearch,  // result = keys
+        BatchSkipped,      // result = pairs dropped by type validation
+        BatchResized,      // result = old count, bucket = new count
+        BatchInserted,     // result = new keys, hash = size, bucket = bucket count
+        BatchFound,        // result = keys found, bucket = keys searched
+        HashSwitch,        // result = HashStrategy::Kind
+        SnapshotLoaded,    // result = entries, bucket = bucket count
+        ProbeAlternate,    // bucket = second-table candidate
+        ProbeStash,        // bucket = first stash slot, result = stashed entries
+        NotInCandidates,
+        Kick,              // key, result = value handle, bucket = from, hash = to
+        KickSettled,       // bucket, result = displacements
+        KickLimit,         // result = displacements tried
+        Stashed,           // bucket, result = stashed entries
+        PlaceInTable       // bucket, result = 0 first table, 1 second table, 2 stash
+    };
+
+    enum Flag : quint16 {
+        SlotUnit = 0x1,  // open addressing: say "slot" rather than "bucket"
+        Target = 0x2,    // highlighted visit (🎯)
+        Numeric = 0x4,   // numeric key: short hash wording
+        Match = 0x8,     // comparison succeeded
+        ForErase = 0x10,     // "not found" wording of the erase path
+        Incremental = 0x20,  // rehash spread over later operations
+        OldTable = 0x40,     // visit in the table being migrated away from
+        Shrink = 0x80,       // Grow step that shrinks below the min load factor
+        HashReject = 0x100,  // compare settled by the stored hash alone
+        MaskReduce = 0x200,      // index = mixed hash & (n - 1)
+        FastRangeReduce = 0x400  // index = high half of mixed hash * n
+    };
+
+    static QString render(const StepEvent &event, const StepLog &log);
+    // Colour class of a row, from the opcode (or the marker of a text row)
+    static StepCategory category(const StepEvent &event, const StepLog &log);
+};
@@ -1,4 +1,7 @@
 #include "hashmapvisualization.h"
+#include "hashmapsnapshot.h"
+#include <QtMath>
+#include <QFileInfo>
 
 
 // Define static constants
@@ -7,14 +10,41 @@ const int HashMapVisualization::BUCKET_HEIGHT = 60;
 const int HashMapVisualization::BUCKET_SPACING = 10;
 const int HashMapVisualization::CHAIN_ITEM_HEIGHT = 25;
 const int HashMapVisualization::MAX_VISIBLE_BUCKETS = 12;
+const int HashMapVisualization::MAX_ENTRIES_PER_BUCKET = 8;
+const int HashMapVisualization::MAX_DETAIL_BUCKETS = 16;
+const int HashMapVisualization::HEATMAP_WIDTH = 1400;
+const int HashMapVisualization::IMPORT_SLICE_MS = 30;
+const int HashMapVisualization::IMPORT_REDRAW_MS = 500;
 
 HashMapVisualization::HashMapVisualization(QWidget *parent)
     : QWidget(parent)
+    , workloadTimer(new QTimer(this))
+    , workload(new ConcurrentWorkload())
+    , importTimer(new QTimer(this))
+    , importer(new HashMapFileLoader())
+    , importedRows(0)
+    , importedKeys(0)
     , hashMap(new HashMap(8, 0.75f))  // 8 buckets, normal load factor (0.75) to enable rehashing
+    , vizTitle(nullptr)
+    , heatmapItem(nullptr)
+    , overviewMode(false)
+    , layoutStale(true)
+    , firstShownBucket(0)
+    , indexFont("Segoe UI", 14)
+    , entryFont("Segoe UI", 8)
+    , arrowFont("Segoe UI", 10)
+    , moreFont("Segoe UI", 8)
+    , emptyFont("Segoe UI", 9)
     , animationTimer(new QTimer(this))
     , highlightRect(nullptr)
     , previousBucketCount(8)
 {
+    indexFont.setBold(true);
+    entryFont.setBold(true);
+    arrowFont.setBold(true);
+    moreFont.setItalic(true);
+    emptyFont.setItalic(true);
+
     setupUI();
     updateVisualization();
     updateStepTrace();
@@ -23,11 +53,22 @@ HashMapVisualization::HashMapVisualization(QWidget *parent)
     animationTimer->setSingleShot(true);
     connect(animationTimer, &QTimer::timeout, this, &HashMapVisualization::updateVisualization);
 
+    // Poll shard counters while a workload runs
+    workloadTimer->setInterval(100);
+    connect(workloadTimer, &QTimer::timeout, this, &HashMapVisualization::updateShardOccupancy);
+
+    // Short ticks with a bounded slice each keep input and painting flowing
+    // during an import
+    importTimer->setInterval(10);
+    connect(importTimer, &QTimer::timeout, this, &HashMapVisualization::drainImport);
+
     setMinimumSize(1200, 800);
 }
 
 HashMapVisualization::~HashMapVisualization()
 {
+    delete workload;
+    delete importer;
     delete hashMap;
 }
 
@@ -91,6 +132,13 @@ void HashMapVisualization::setupVisualizationArea()
     // Visualization area with gradient background (fixed size, no scroll)
     scene = new QGraphicsScene(this);
 
+    // Scene title, shared by the bucket boxes and the heatmap
+    QFont vizTitleFont("Segoe UI", 16);
+    vizTitleFont.setBold(true);
+    vizTitle = scene->addText(QString());
+    vizTitle->setFont(vizTitleFont);
+    vizTitle->setDefaultTextColor(QColor(44, 62, 80));
+
     visualizationView = new QGraphicsView(scene);
     visualizationView->setRenderHint(QPainter::Antialiasing);
     visualizationView->setFixedHeight(450);
@@ -114,18 +162,14 @@ void HashMapVisualization::setupVisualizationArea()
     viewShadow->setColor(QColor(74, 144, 226, 25));
     visualizationView->setGraphicsEffect(viewShadow);
 
+    // Wheel and clicks switch between the heatmap and the bucket boxes
+    visualizationView->viewport()->installEventFilter(this);
+
     leftLayout->addWidget(visualizationView, 1);
 
     // Bottom note about bucket limitation
     bucketNote = new QLabel(QString("* Buckets shown: %1").arg(hashMap->bucketCount()));
-    bucketNote->setStyleSheet(R"(
-        QLabel {
-            color: #7f8c8d;
-            font-size: 11px;
-            font-style: italic;
-            padding: 5px;
-        }
-    )");
+    StyleManager::instance().applyBucketNoteStyle(bucketNote);
     bucketNote->setAlignment(Qt::AlignLeft);
     leftLayout->addWidget(bucketNote);
 }
@@ -145,6 +189,10 @@ void HashMapVisualization::setupStatsAndControls()
     loadFactorLabel = new QLabel("Load Factor: 0.00");
     loadFactorWarning = new QLabel("");
     loadFactorWarning->setVisible(false);
+    StyleManager::instance().applyLoadFactorWarningStyle(loadFactorWarning);
+    distributionLabel = new QLabel("χ²: 0.0 (df 0) · Max chain: 0");
+    distributionLabel->setToolTip("Chi-squared of entries per home bucket against a uniform spread. "
+                                  "Close to df (buckets − 1) means the hash spreads keys evenly.");
     
     QString statsStyle = R"(
         QLabel {
@@ -161,12 +209,14 @@ void HashMapVisualization::setupStatsAndControls()
 
     sizeLabel->setStyleSheet(statsStyle);
     bucketCountLabel->setStyleSheet(statsStyle);
-    loadFactorLabel->setStyleSheet(statsStyle);
+    StyleManager::instance().applyLoadFactorStyle(loadFactorLabel);
+    distributionLabel->setStyleSheet(statsStyle);
 
     statsLayout->addWidget(sizeLabel);
     statsLayout->addWidget(bucketCountLabel);
     statsLayout->addWidget(loadFactorLabel);
     statsLayout->addWidget(loadFactorWarning);
+    statsLayout->addWidget(distributionLabel);
     statsLayout->addStretch();
 
     // Controls row (similar to Red Black Tree format)
@@ -303,6 +353,85 @@ void HashMapVisualization::setupStatsAndControls()
         QPushButton:disabled { background: #cccccc; }
     )");
 
+    randomCountCombo = new QComboBox();
+    for (int count : {1, 10, 100, 1000, 10000, 100000}) {
+        randomCountCombo->addItem(QString("×%1").arg(count), count);
+    }
+    randomCountCombo->setFixedHeight(35);
+    randomCountCombo->setToolTip("Pairs generated per Random click");
+    randomCountCombo->setStyleSheet(R"(
+        QComboBox {
+            background-color: white;
+            border: 2px solid #d0c5e8;
+            border-radius: 17px;
+            padding: 4px 12px;
+            color: #2d1b69;
+            font-size: 10px;
+            font-weight: bold;
+        }
+        QComboBox:focus { border-color: #28a745; }
+        QComboBox::drop-down { border: none; width: 18px; }
+    )");
+
+    // Snapshot buttons share one style
+    const QString snapshotButtonStyle = R"(
+        QPushButton {
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:1,
+                stop:0 #6c5ce7, stop:1 #8e7cf0);
+            color: white;
+            border: none;
+            border-radius: 17px;
+            font-weight: bold;
+            font-size: 10px;
+        }
+        QPushButton:hover {
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:1,
+                stop:0 #5a4bd1, stop:1 #6c5ce7);
+        }
+        QPushButton:disabled { background: #cccccc; }
+    )";
+
+    saveButton = new QPushButton("Save");
+    saveButton->setFixedSize(60, 35);
+    saveButton->setCursor(Qt::PointingHandCursor);
+    saveButton->setToolTip("Write the contents to a binary snapshot file");
+    saveButton->setStyleSheet(snapshotButtonStyle);
+
+    openButton = new QPushButton("Open");
+    openButton->setFixedSize(60, 35);
+    openButton->setCursor(Qt::PointingHandCursor);
+    openButton->setToolTip("Replace the contents with a snapshot file, restored in one batch");
+    openButton->setStyleSheet(snapshotButtonStyle);
+
+    importButton = new QPushButton("Import");
+    importButton->setFixedSize(60, 35);
+    importButton->setCursor(Qt::PointingHandCursor);
+    importButton->setToolTip("Add key/value pairs from a CSV or TSV file, parsed on a background thread");
+    importButton->setStyleSheet(snapshotButtonStyle);
+
+    // Shown only while an import runs
+    importProgress = new QProgressBar();
+    importProgress->setRange(0, 1000);
+    importProgress->setTextVisible(true);
+    importProgress->setFixedHeight(22);
+    importProgress->setVisible(false);
+    importProgress->setStyleSheet(R"(
+        QProgressBar {
+            color: #2d1b69;
+            font-size: 11px;
+            font-weight: bold;
+            text-align: center;
+            background: rgba(108, 92, 231, 0.08);
+            border: 1px solid rgba(108, 92, 231, 0.3);
+            border-radius: 8px;
+        }
+        QProgressBar::chunk {
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:0,
+                stop:0 #6c5ce7, stop:1 #8e7cf0);
+            border-radius: 7px;
+        }
+    )");
+
     controlLayout->addWidget(keyInput);
     controlLayout->addWidget(valueInput);
     controlLayout->addWidget(insertButton);
@@ -310,6 +439,10 @@ void HashMapVisualization::setupStatsAndControls()
     controlLayout->addWidget(searchButton);
     controlLayout->addWidget(clearButton);
     controlLayout->addWidget(randomizeButton);
+    controlLayout->addWidget(randomCountCombo);
+    controlLayout->addWidget(saveButton);
+    controlLayout->addWidget(openButton);
+    controlLayout->addWidget(importButton);
     controlLayout->addStretch();
 
     // Connect signals
@@ -318,9 +451,13 @@ void HashMapVisualization::setupStatsAndControls()
     connect(deleteButton, &QPushButton::clicked, this, &HashMapVisualization::onDeleteClicked);
     connect(clearButton, &QPushButton::clicked, this, &HashMapVisualization::onClearClicked);
     connect(randomizeButton, &QPushButton::clicked, this, &HashMapVisualization::onRandomizeClicked);
+    connect(saveButton, &QPushButton::clicked, this, &HashMapVisualization::onSaveClicked);
+    connect(openButton, &QPushButton::clicked, this, &HashMapVisualization::onOpenClicked);
+    connect(importButton, &QPushButton::clicked, this, &HashMapVisualization::onImportClicked);
 
     topLayout->addLayout(statsLayout);
     topLayout->addLayout(controlLayout);
+    topLayout->addWidget(importProgress);
     leftLayout->addLayout(topLayout);
 }
 
@@ -427,8 +564,17 @@ void HashMapVisualization::setupStepTraceTop()
     )");
 
     // Steps tab - using StyleManager for beautiful scroll bars (like BST)
-    stepsList = new QListWidget();
+    stepsList = new QListView();
     StyleManager::instance().applyStepTraceStyle(stepsList);
+    stepsList->setUniformItemSizes(true);
+    stepsModel = new StepListModel(&hashMap->lastSteps(), this);
+    stepsModel->setCategoryColor(StepCategory::Success, QColor(39, 174, 96));     // Green for success
+    stepsModel->setCategoryColor(StepCategory::Failure, QColor(231, 76, 60));     // Red for failure
+    stepsModel->setCategoryColor(StepCategory::Search, QColor(52, 152, 219));     // Blue for search
+    stepsModel->setCategoryColor(StepCategory::Insert, QColor(46, 125, 50));      // Green for insert/put
+    stepsModel->setCategoryColor(StepCategory::Delete, QColor(211, 47, 47));      // Red for delete
+    stepsModel->setCategoryColor(StepCategory::Calculate, QColor(155, 89, 182));  // Purple for calculation
+    stepsList->setModel(stepsModel);
 
     // Algorithm tab - using StyleManager for beautiful scroll bars (like BST)
     algorithmList = new QListWidget();
@@ -437,11 +583,131 @@ void HashMapVisualization::setupStepTraceTop()
     // Add both widgets to tabs with enhanced names and icons
     traceTabWidget->addTab(stepsList, "📝 Steps");
     traceTabWidget->addTab(algorithmList, "⚙️ Algorithm");
+    traceTabWidget->addTab(createConcurrencyTab(), "🧵 Threads");
 
     traceLayout->addWidget(traceTabWidget);
     rightLayout->addWidget(traceGroup, 2);  // Give it more space (2/3 of right panel)
 }
 
+QWidget *HashMapVisualization::createConcurrencyTab()
+{
+    QWidget *tab = new QWidget();
+    QVBoxLayout *layout = new QVBoxLayout(tab);
+    layout->setContentsMargins(10, 10, 10, 10);
+    layout->setSpacing(8);
+
+    QHBoxLayout *controls = new QHBoxLayout();
+    QLabel *threadsLabel = new QLabel("Threads:");
+    threadsLabel->setStyleSheet("color: #1a1a2e; font-weight: 700; font-size: 12px; background: transparent;");
+
+    threadCountCombo = new QComboBox();
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        threadCountCombo->addItem(QString::number(threads), threads);
+    }
+    const int ideal = QThread::idealThreadCount();
+    int preferred = 0;
+    for (int i = 0; i < threadCountCombo->count(); ++i) {
+        if (threadCountCombo->itemData(i).toInt() <= ideal) preferred = i;
+    }
+    threadCountCombo->setCurrentIndex(preferred);
+
+    workloadButton = new QPushButton("Run");
+    workloadButton->setFixedSize(75, 30);
+    workloadButton->setCursor(Qt::PointingHandCursor);
+    workloadButton->setStyleSheet(R"(
+        QPushButton {
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:1,
+                stop:0 #7b4fff, stop:1 #9b6fff);
+            color: white;
+            border: none;
+            border-radius: 15px;
+            font-weight: bold;
+            font-size: 10px;
+        }
+        QPushButton:hover {
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:1,
+                stop:0 #6c3cff, stop:1 #8b5fff);
+        }
+    )");
+    connect(workloadButton, &QPushButton::clicked, this, &HashMapVisualization::onRunWorkloadClicked);
+
+    controls->addWidget(threadsLabel);
+    controls->addWidget(threadCountCombo);
+    controls->addWidget(workloadButton);
+    controls->addStretch();
+    layout->addLayout(controls);
+
+    workloadStatus = new QLabel("Each thread runs 250k random ops (50% get, 45% put, 5% erase) "
+                                "on a 16-shard ConcurrentHashMap<int, int>");
+    workloadStatus->setWordWrap(true);
+    workloadStatus->setStyleSheet("color: #34495e; font-size: 11px; background: transparent;");
+    layout->addWidget(workloadStatus);
+
+    shardList = new QListWidget();
+    StyleManager::instance().applyStepTraceStyle(shardList);
+    layout->addWidget(shardList, 1);
+
+    return tab;
+}
+
+void HashMapVisualization::onRunWorkloadClicked()
+{
+    if (workload->isRunning()) {
+        workload->stop();
+        updateShardOccupancy();
+        return;
+    }
+
+    ConcurrentWorkload::Options options;
+    options.threads = threadCountCombo->currentData().toInt();
+    workload->start(options);
+    workloadButton->setText("Stop");
+    threadCountCombo->setEnabled(false);
+    workloadTimer->start();
+    updateShardOccupancy();
+}
+
+void HashMapVisualization::updateShardOccupancy()
+{
+    const QVector<int> sizes = workload->shardSizes();
+    const int largest = sizes.isEmpty() ? 0 : *std::max_element(sizes.cbegin(), sizes.cend());
+    const int total = workload->size();
+    const double mean = sizes.isEmpty() ? 0.0 : static_cast<double>(total) / sizes.size();
+
+    // One row per shard, bar scaled to the fullest shard
+    const int BarWidth = 20;
+    if (shardList->count() != sizes.size()) {
+        shardList->clear();
+        for (int i = 0; i < sizes.size(); ++i) shardList->addItem(QString());
+    }
+    for (int i = 0; i < sizes.size(); ++i) {
+        const int filled = largest > 0 ? (sizes[i] * BarWidth + largest - 1) / largest : 0;
+        shardList->item(i)->setText(QString("Shard %1  %2%3  %4")
+                                        .arg(i, 2, 10, QChar('0'))
+                                        .arg(QString(filled, QChar(0x2588)))
+                                        .arg(QString(BarWidth - filled, QChar(0x2591)))
+                                        .arg(sizes[i]));
+    }
+
+    const qint64 elapsed = qMax<qint64>(1, workload->elapsedMs());
+    const qint64 ops = workload->completedOps();
+    workloadStatus->setText(QString("%1 thread(s): %2 ops in %3 ms (%4 Mops/s), %5 entries, "
+                                    "fullest shard %6 vs mean %7")
+                                .arg(workload->options().threads)
+                                .arg(ops)
+                                .arg(elapsed)
+                                .arg(static_cast<double>(ops) / elapsed / 1000.0, 0, 'f', 2)
+                                .arg(total)
+                                .arg(largest)
+                                .arg(mean, 0, 'f', 1));
+
+    if (!workload->isRunning()) {
+        workloadTimer->stop();
+        workloadButton->setText("Run");
+        threadCountCombo->setEnabled(true);
+    }
+}
+
 void HashMapVisualization::setupTypeSelection()
 {
     typeGroup = new QGroupBox("");
@@ -501,6 +767,25 @@ void HashMapVisualization::setupTypeSelection()
     valueTypeCombo = new QComboBox();
     valueTypeCombo->addItems({"String", "Integer", "Double", "Float", "Char"});
 
+    QLabel *backendLabel = new QLabel("Storage:");
+    backendLabel->setStyleSheet("color: #1a1a2e; font-weight: 700; font-size: 13px; background: transparent;");
+    backendCombo = new QComboBox();
+    backendCombo->addItems({"Chaining", "Robin Hood", "Swiss Table", "Cuckoo"});
+
+    QLabel *hashLabel = new QLabel("Hash:");
+    hashLabel->setStyleSheet("color: #1a1a2e; font-weight: 700; font-size: 13px; background: transparent;");
+    hashCombo = new QComboBox();
+    for (HashStrategy::Kind kind : {HashStrategy::STD_HASH, HashStrategy::WY_MIX, HashStrategy::MULTIPLY_SHIFT}) {
+        hashCombo->addItem(HashStrategy::name(kind), static_cast<int>(kind));
+    }
+
+    QLabel *reducerLabel = new QLabel("Index:");
+    reducerLabel->setStyleSheet("color: #1a1a2e; font-weight: 700; font-size: 13px; background: transparent;");
+    reducerCombo = new QComboBox();
+    reducerCombo->addItems({"h % n", "Mask (2ᵏ)", "Fastrange"});
+    reducerCombo->setToolTip("How the hash becomes a bucket index. Mask and fastrange avoid the division; "
+                             "the Swiss table always masks.");
+
     QString comboStyle = R"(
         QComboBox {
             border: 2px solid rgba(123, 79, 255, 0.3);
@@ -572,6 +857,9 @@ void HashMapVisualization::setupTypeSelection()
 
     keyTypeCombo->setStyleSheet(comboStyle);
     valueTypeCombo->setStyleSheet(comboStyle);
+    backendCombo->setStyleSheet(comboStyle);
+    hashCombo->setStyleSheet(comboStyle);
+    reducerCombo->setStyleSheet(comboStyle);
 
     // Horizontal layout: Key [dropdown] Value [dropdown]
     typeLayout->addWidget(keyLabel);
@@ -580,194 +868,321 @@ void HashMapVisualization::setupTypeSelection()
     typeLayout->addWidget(valueTypeCombo);
     typeLayout->addStretch();
 
-    // Add the horizontal layout to the main vertical layout
+    // Second row: Storage [dropdown] Hash [dropdown] Index [dropdown]
+    QHBoxLayout *backendLayout = new QHBoxLayout();
+    backendLayout->setContentsMargins(15, 0, 15, 10);
+    backendLayout->setSpacing(20);
+    backendLayout->addWidget(backendLabel);
+    backendLayout->addWidget(backendCombo);
+    backendLayout->addWidget(hashLabel);
+    backendLayout->addWidget(hashCombo);
+    backendLayout->addWidget(reducerLabel);
+    backendLayout->addWidget(reducerCombo);
+    backendLayout->addStretch();
+
+    // Add the horizontal layouts to the main vertical layout
     typeMainLayout->addLayout(typeLayout);
+    typeMainLayout->addLayout(backendLayout);
 
     connect(keyTypeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &HashMapVisualization::onTypeChanged);
     connect(valueTypeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &HashMapVisualization::onTypeChanged);
+    connect(backendCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &HashMapVisualization::onTypeChanged);
+    connect(hashCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &HashMapVisualization::onHashStrategyChanged);
+    connect(reducerCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &HashMapVisualization::onReducerChanged);
 
     rightLayout->addWidget(typeGroup);
 }
 
 
 
-void HashMapVisualization::setupStepTrace()
+void HashMapVisualization::drawBuckets()
 {
-    traceGroup = new QGroupBox("Operation History");
-    traceGroup->setStyleSheet(R"(
-        QGroupBox {
-            font-weight: bold;
-            font-size: 14px;
-            color: #2d1b69;
-            border: 2px solid rgba(123, 79, 255, 0.2);
-            border-radius: 10px;
-            margin-top: 10px;
-            padding-top: 10px;
-        }
-        QGroupBox::title {
-            subcontrol-origin: margin;
-            left: 10px;
-            padding: 0 5px 0 5px;
-        }
-    )");
+    const int bucketCount = hashMap->bucketCount();
+    const HashMapDirtySet dirty = hashMap->takeDirtyBuckets();
+
+    // Zoom out on its own once the table outgrows the bucket boxes
+    if (bucketCount <= MAX_DETAIL_BUCKETS) {
+        setOverview(false);
+    } else if (previousBucketCount <= MAX_DETAIL_BUCKETS) {
+        setOverview(true);
+    }
 
-    QVBoxLayout *traceLayout = new QVBoxLayout(traceGroup);
+    if (overviewMode) {
+        // One pass over the bucket lengths; no per-bucket items
+        if (layoutStale || !dirty.isEmpty()) drawHeatmap();
+        layoutStale = false;
+        return;
+    }
 
-    stepsList = new QListWidget();
-    stepsList->setStyleSheet(R"(
-        QListWidget {
-            background: white;
-            border: 1px solid rgba(123, 79, 255, 0.2);
-            border-radius: 8px;
-            padding: 5px;
-            font-family: 'Segoe UI';
-            font-size: 12px;
-        }
-        QListWidget::item {
-            padding: 6px;
-            border-bottom: 1px solid #f0f0f0;
+    const int shownBuckets = qMin(bucketCount, MAX_DETAIL_BUCKETS);
+    firstShownBucket = qBound(0, firstShownBucket, bucketCount - shownBuckets);
+
+    if (layoutStale || dirty.all() || shownBuckets != bucketItems.size()) {
+        // New table shape, backend or window: lay every shown bucket out again
+        buildBucketItems(shownBuckets);
+        for (int i = 0; i < shownBuckets; ++i) {
+            updateBucketItems(firstShownBucket + i);
         }
-        QListWidget::item:selected {
-            background: rgba(123, 79, 255, 0.1);
+        layoutStale = false;
+    } else {
+        if (dirty.isEmpty()) return;
+        for (int bucket : dirty) {
+            if (bucket >= firstShownBucket && bucket < firstShownBucket + shownBuckets) updateBucketItems(bucket);
         }
-    )");
+    }
 
-    traceLayout->addWidget(stepsList);
-    rightLayout->addWidget(traceGroup, 1);  // Give it more space
+    // Adjust scene rect with padding; frames contain all their children
+    // except the index label, which sits below the title
+    QRectF bounds = vizTitle->sceneBoundingRect();
+    for (const BucketItems &items : bucketItems) {
+        bounds |= items.frame->sceneBoundingRect();
+    }
+    scene->setSceneRect(bounds.adjusted(-60, -100, 60, 80));
 }
 
+void HashMapVisualization::drawHeatmap()
+{
+    // Match the aspect of the area the bucket boxes would cover
+    heatmap.render(hashMap->bucketSizes(), 3.0);
 
-void HashMapVisualization::drawBuckets()
+    if (!heatmapItem) {
+        heatmapItem = scene->addPixmap(QPixmap());
+        // Keep cells crisp when scaled up
+        heatmapItem->setTransformationMode(Qt::FastTransformation);
+    }
+    heatmapItem->setPixmap(QPixmap::fromImage(heatmap.image()));
+    const qreal cellSize = static_cast<qreal>(HEATMAP_WIDTH) / heatmap.image().width();
+    heatmapItem->setScale(cellSize);
+    heatmapItem->setPos(-HEATMAP_WIDTH / 2, 0);
+
+    QString title = QString("Hash Map (%1) · %2 buckets, longest %3")
+                        .arg(HashMap::backendToString(hashMap->getBackend()))
+                        .arg(heatmap.bucketCount())
+                        .arg(heatmap.maxLength());
+    if (heatmap.bucketsPerPixel() > 1) title += QString(" · %1 per cell").arg(heatmap.bucketsPerPixel());
+    vizTitle->setPlainText(title);
+    vizTitle->setPos(-HEATMAP_WIDTH / 2, -120);
+
+    scene->setSceneRect((vizTitle->sceneBoundingRect() | heatmapItem->sceneBoundingRect()).adjusted(-60, -100, 60, 80));
+}
+
+void HashMapVisualization::setOverview(bool overview, int centerBucket)
 {
-    // Clear existing visualization
-    scene->clear();
-    bucketRects.clear();
-    bucketTexts.clear();
-    chainTexts.clear();
-
-    int actualBucketCount = hashMap->bucketCount();
-    // Limit display to 16 buckets for visualization
-    const int bucketCount = qMin(actualBucketCount, 16);
-    const QVector<int> bucketSizes = hashMap->bucketSizes();
-    const QVector<QVector<QPair<QVariant, QVariant>>> bucketContents = hashMap->getBucketContents();
+    if (!overview) {
+        // Centre the window of bucket boxes on the bucket zoomed into
+        const int window = qMin(hashMap->bucketCount(), MAX_DETAIL_BUCKETS);
+        const int first = qBound(0, centerBucket - window / 2, hashMap->bucketCount() - window);
+        if (!overviewMode && first == firstShownBucket) return;
+        firstShownBucket = first;
+    } else if (overviewMode) {
+        return;
+    }
+    overviewMode = overview;
+    layoutStale = true;
 
-    // Calculate layout for all buckets in a single row
-    const int totalWidth = bucketCount * (BUCKET_WIDTH + BUCKET_SPACING) - BUCKET_SPACING;
-    const int startX = -totalWidth / 2;
+    // Only one representation lives in the scene at a time
+    if (overview) {
+        buildBucketItems(0);
+    } else {
+        delete heatmapItem;
+        heatmapItem = nullptr;
+    }
+}
 
-    bucketRects.resize(bucketCount);
-    bucketTexts.resize(bucketCount);
-    chainTexts.resize(bucketCount);
+QRectF HashMapVisualization::bucketSceneRect(int bucket) const
+{
+    if (overviewMode) {
+        const QPoint pixel = heatmap.pixelOf(bucket);
+        return heatmapItem ? heatmapItem->mapRectToScene(QRectF(pixel, QSizeF(1, 1))) : QRectF();
+    }
+    const int offset = bucket - firstShownBucket;
+    if (offset < 0 || offset >= bucketItems.size()) return QRectF();
+    return bucketItems[offset].frame->sceneBoundingRect();
+}
 
-    for (int i = 0; i < bucketCount; ++i) {
-        const int x = startX + i * (BUCKET_WIDTH + BUCKET_SPACING);
-        const int y = 0;
+bool HashMapVisualization::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched != visualizationView->viewport() || hashMap->bucketCount() <= MAX_DETAIL_BUCKETS) {
+        return QWidget::eventFilter(watched, event);
+    }
 
-        // Calculate dynamic bucket height based on content
-        int bucketHeight = BUCKET_HEIGHT;
-        if (i < bucketContents.size() && !bucketContents[i].isEmpty()) {
-            bucketHeight = BUCKET_HEIGHT + (bucketContents[i].size() * 30); // 30px per item
+    if (event->type() == QEvent::Wheel) {
+        QWheelEvent *wheel = static_cast<QWheelEvent *>(event);
+        const QPoint delta = wheel->angleDelta();
+        if (overviewMode && delta.y() > 0) {
+            // Scroll up over a cell: zoom into the buckets around it
+            const QPointF local = heatmapItem->mapFromScene(visualizationView->mapToScene(wheel->position().toPoint()));
+            const int bucket = heatmap.bucketAt(qFloor(local.x()), qFloor(local.y()));
+            if (bucket >= 0) setOverview(false, bucket);
+        } else if (!overviewMode && ((wheel->modifiers() & Qt::ShiftModifier) || delta.x() != 0)) {
+            // Shift+scroll pans the window of bucket boxes
+            const int step = (delta.x() != 0 ? delta.x() : delta.y()) > 0 ? -4 : 4;
+            firstShownBucket += step;
+            layoutStale = true;
+        } else if (!overviewMode && delta.y() < 0) {
+            setOverview(true);
+        }
+        if (layoutStale) {
+            drawBuckets();
+            zoomToFit();
+            showStats();
         }
+        return true;
+    }
 
-        // Create bucket with dynamic height
-        QGraphicsPathItem *bucketPath = new QGraphicsPathItem();
-        QPainterPath path;
-        path.addRoundedRect(QRectF(x, y, BUCKET_WIDTH, bucketHeight), 12, 12);
-        bucketPath->setPath(path);
-
-        // Set gradient brush for bucket
-        QLinearGradient bucketGradient(x, y, x, y + bucketHeight);
-        if (bucketSizes[i] > 0) {
-            // Filled bucket - purple gradient
-            bucketGradient.setColorAt(0.0, QColor(123, 79, 255, 15));
-            bucketGradient.setColorAt(1.0, QColor(123, 79, 255, 25));
-        } else {
-            // Empty bucket - light gradient
-            bucketGradient.setColorAt(0.0, QColor(255, 255, 255, 200));
-            bucketGradient.setColorAt(1.0, QColor(250, 248, 255, 200));
+    if (event->type() == QEvent::MouseButtonPress && overviewMode) {
+        // Clicking a cell zooms in too
+        QMouseEvent *click = static_cast<QMouseEvent *>(event);
+        const QPointF local = heatmapItem->mapFromScene(visualizationView->mapToScene(click->pos()));
+        const int bucket = heatmap.bucketAt(qFloor(local.x()), qFloor(local.y()));
+        if (bucket >= 0) {
+            setOverview(false, bucket);
+            drawBuckets();
+            zoomToFit();
+            showStats();
+            return true;
         }
-        bucketPath->setBrush(QBrush(bucketGradient));
-        bucketPath->setPen(QPen(QColor(123, 79, 255, 120), 2.5));
-        scene->addItem(bucketPath);
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void HashMapVisualization::buildBucketItems(int shownBuckets)
+{
+    // Deleting a frame deletes its children too
+    for (const BucketItems &items : bucketItems) {
+        delete items.frame;
+    }
+    bucketItems.clear();
+    if (shownBuckets == 0) return;
+    bucketItems.resize(shownBuckets);
+
+    // Calculate layout for all buckets in a single row
+    const int totalWidth = shownBuckets * (BUCKET_WIDTH + BUCKET_SPACING) - BUCKET_SPACING;
+    const int startX = -totalWidth / 2;
+
+    for (int i = 0; i < shownBuckets; ++i) {
+        BucketItems &items = bucketItems[i];
+
+        // Children are positioned relative to the bucket's top left corner
+        items.frame = new QGraphicsPathItem();
+        items.frame->setPos(startX + i * (BUCKET_WIDTH + BUCKET_SPACING), 0);
+        items.frame->setPen(QPen(QColor(123, 79, 255, 120), 2.5));
+        scene->addItem(items.frame);
 
         // Bucket index label
-        QGraphicsTextItem *indexText = scene->addText(QString::number(i));
-        indexText->setPos(x + BUCKET_WIDTH/2 - 8, y - 35);
+        const QString index = QString::number(firstShownBucket + i);
+        QGraphicsTextItem *indexText = new QGraphicsTextItem(index, items.frame);
+        indexText->setPos(BUCKET_WIDTH/2 - 4 * index.size(), -35);
         indexText->setDefaultTextColor(QColor(45, 27, 105));
-        QFont indexFont("Segoe UI", 14);
-        indexFont.setBold(true);
         indexText->setFont(indexFont);
 
-        // Show data directly inside the bucket
-        QVector<QGraphicsTextItem*> chainItems;
-        if (i < bucketContents.size()) {
-            const auto &items = bucketContents[i];
-            for (int j = 0; j < items.size(); ++j) {
-                const int itemY = y + 10 + j * 30; // Items stacked vertically inside bucket
-
-                // Chain item background inside bucket
-                QGraphicsPathItem *itemBgPath = new QGraphicsPathItem();
-                QPainterPath itemPath;
-                itemPath.addRoundedRect(QRectF(x + 4, itemY, BUCKET_WIDTH - 8, 25), 6, 6);
-                itemBgPath->setPath(itemPath);
-                itemBgPath->setBrush(QBrush(QColor(255, 255, 255, 180)));
-                itemBgPath->setPen(QPen(QColor(123, 79, 255, 100), 1.5));
-                itemBgPath->setZValue(1);
-                scene->addItem(itemBgPath);
-
-                // Chain item text with actual key-value pair
-                const QVariant &key = items[j].first;
-                const QVariant &value = items[j].second;
-                QString keyStr = HashMap::variantToDisplayString(key);
-                QString valueStr = HashMap::variantToDisplayString(value);
-                QString displayText = QString("%1→%2").arg(keyStr.left(4), valueStr.left(4));
-
-                QGraphicsTextItem *chainItem = scene->addText(displayText);
-                chainItem->setPos(x + 6, itemY + 2);
-                chainItem->setDefaultTextColor(QColor(45, 27, 105));
-                QFont chainFont("Segoe UI", 8);
-                chainFont.setBold(true);
-                chainItem->setFont(chainFont);
-                chainItem->setZValue(2);
-                chainItems.append(chainItem);
-
-                // Add chain link arrow for multiple items
-                if (j > 0) {
-                    QGraphicsTextItem *arrow = scene->addText("↓");
-                    arrow->setPos(x + BUCKET_WIDTH/2 - 5, itemY - 15);
-                    arrow->setDefaultTextColor(QColor(123, 79, 255, 150));
-                    QFont arrowFont("Segoe UI", 10);
-                    arrowFont.setBold(true);
-                    arrow->setFont(arrowFont);
-                    arrow->setZValue(2);
-                }
-            }
-        }
-        chainTexts[i] = chainItems;
+        // Entries past the cap are counted, not drawn
+        items.moreText = new QGraphicsTextItem(items.frame);
+        items.moreText->setDefaultTextColor(QColor(123, 79, 255, 200));
+        items.moreText->setFont(moreFont);
+        items.moreText->setZValue(2);
 
         // Empty bucket label
-        if (bucketSizes[i] == 0) {
-            QGraphicsTextItem *emptyText = scene->addText("empty");
-            emptyText->setPos(x + BUCKET_WIDTH/2 - 15, y + BUCKET_HEIGHT/2 - 10);
-            emptyText->setDefaultTextColor(QColor(150, 150, 150));
-            QFont emptyFont("Segoe UI", 9);
-            emptyFont.setItalic(true);
-            emptyText->setFont(emptyFont);
-            emptyText->setZValue(2);
-        }
+        items.emptyText = new QGraphicsTextItem("empty", items.frame);
+        items.emptyText->setPos(BUCKET_WIDTH/2 - 15, BUCKET_HEIGHT/2 - 10);
+        items.emptyText->setDefaultTextColor(QColor(150, 150, 150));
+        items.emptyText->setFont(emptyFont);
+        items.emptyText->setZValue(2);
     }
 
-    // Add title higher up
-    QGraphicsTextItem *vizTitle = scene->addText("Hash Map (Open Chaining)");
-    QFont titleFont("Segoe UI", 16);
-    titleFont.setBold(true);
-    vizTitle->setFont(titleFont);
-    vizTitle->setDefaultTextColor(QColor(44, 62, 80));
+    // Title higher up
+    vizTitle->setPlainText(QString("Hash Map (%1)").arg(HashMap::backendToString(hashMap->getBackend())));
     vizTitle->setPos(-totalWidth/2, -120);
+}
+
+void HashMapVisualization::updateBucketItems(int bucket)
+{
+    BucketItems &items = bucketItems[bucket - firstShownBucket];
+
+    // Read the shown entries in place; long chains are cut off
+    const HashMap::BucketView entries = hashMap->bucketView(bucket, MAX_ENTRIES_PER_BUCKET);
+    const int hiddenEntries = entries.total() - entries.size();
+
+    // Calculate dynamic bucket height based on content
+    const int bucketHeight = bucketHeightFor(entries.size(), hiddenEntries);
+    QPainterPath path;
+    path.addRoundedRect(QRectF(0, 0, BUCKET_WIDTH, bucketHeight), 12, 12);
+    items.frame->setPath(path);
+
+    // Set gradient brush for bucket
+    QLinearGradient bucketGradient(0, 0, 0, bucketHeight);
+    if (entries.total() > 0) {
+        // Filled bucket - purple gradient
+        bucketGradient.setColorAt(0.0, QColor(123, 79, 255, 15));
+        bucketGradient.setColorAt(1.0, QColor(123, 79, 255, 25));
+    } else {
+        // Empty bucket - light gradient
+        bucketGradient.setColorAt(0.0, QColor(255, 255, 255, 200));
+        bucketGradient.setColorAt(1.0, QColor(250, 248, 255, 200));
+    }
+    items.frame->setBrush(QBrush(bucketGradient));
+
+    // Show data directly inside the bucket, reusing the items already made
+    int j = 0;
+    for (const HashMap::BucketView::Entry &entry : entries) {
+        const int itemY = 10 + j * 30; // Items stacked vertically inside bucket
+
+        if (j == items.entryTexts.size()) {
+            // Chain item background inside bucket
+            QGraphicsPathItem *itemBgPath = new QGraphicsPathItem(items.frame);
+            QPainterPath itemPath;
+            itemPath.addRoundedRect(QRectF(4, itemY, BUCKET_WIDTH - 8, 25), 6, 6);
+            itemBgPath->setPath(itemPath);
+            itemBgPath->setBrush(QBrush(QColor(255, 255, 255, 180)));
+            itemBgPath->setPen(QPen(QColor(123, 79, 255, 100), 1.5));
+            itemBgPath->setZValue(1);
+            items.entryBackgrounds.append(itemBgPath);
+
+            QGraphicsTextItem *chainItem = new QGraphicsTextItem(items.frame);
+            chainItem->setPos(6, itemY + 2);
+            chainItem->setDefaultTextColor(QColor(45, 27, 105));
+            chainItem->setFont(entryFont);
+            chainItem->setZValue(2);
+            items.entryTexts.append(chainItem);
+
+            // Chain link arrow from the previous item
+            if (j > 0) {
+                QGraphicsTextItem *arrow = new QGraphicsTextItem("↓", items.frame);
+                arrow->setPos(BUCKET_WIDTH/2 - 5, itemY - 15);
+                arrow->setDefaultTextColor(QColor(123, 79, 255, 150));
+                arrow->setFont(arrowFont);
+                arrow->setZValue(2);
+                items.arrows.append(arrow);
+            }
+        }
 
+        // Chain item text with actual key-value pair
+        const QString keyStr = HashMap::variantToDisplayString(entry.first);
+        const QString valueStr = HashMap::variantToDisplayString(entry.second);
+        items.entryTexts[j]->setPlainText(QString("%1→%2").arg(keyStr.left(4), valueStr.left(4)));
+        items.entryTexts[j]->setVisible(true);
+        items.entryBackgrounds[j]->setVisible(true);
+        if (j > 0) items.arrows[j - 1]->setVisible(true);
+        ++j;
+    }
+    for (int k = j; k < items.entryTexts.size(); ++k) {
+        items.entryTexts[k]->setVisible(false);
+        items.entryBackgrounds[k]->setVisible(false);
+        if (k > 0) items.arrows[k - 1]->setVisible(false);
+    }
 
-    // Adjust scene rect with padding
-    scene->setSceneRect(scene->itemsBoundingRect().adjusted(-60, -100, 60, 80));
+    items.moreText->setVisible(hiddenEntries > 0);
+    if (hiddenEntries > 0) {
+        items.moreText->setPlainText(QString("+%1 more").arg(hiddenEntries));
+        items.moreText->setPos(10, 10 + entries.size() * 30);
+    }
+    items.emptyText->setVisible(entries.total() == 0);
+}
+
+int HashMapVisualization::bucketHeightFor(int shownEntries, int hiddenEntries) const
+{
+    // 30px per drawn item, plus one row for the "+N more" note
+    return BUCKET_HEIGHT + shownEntries * 30 + (hiddenEntries > 0 ? 30 : 0);
 }
 
 void HashMapVisualization::updateVisualization()
@@ -808,49 +1223,12 @@ void HashMapVisualization::zoomToFit()
 
 void HashMapVisualization::updateStepTrace()
 {
-    stepsList->clear();
-    const QVector<QString> &steps = hashMap->lastSteps();
-
-    for (int i = 0; i < steps.size(); ++i) {
-        const QString &step = steps[i];
-
-        // Handle separator lines
-        if (step == "────────────────────") {
-            QListWidgetItem *separator = new QListWidgetItem(step);
-            separator->setTextAlignment(Qt::AlignCenter);
-            separator->setFlags(Qt::NoItemFlags); // Make it non-selectable
-            separator->setForeground(QColor(189, 195, 199));
-            stepsList->addItem(separator);
-            continue;
-        }
-
-        // Add step with better formatting
-        QListWidgetItem *item = new QListWidgetItem(step);
-
-        // Style different types of steps
-        if (step.contains("✅")) {
-            item->setForeground(QColor(39, 174, 96)); // Green for success
-        } else if (step.contains("❌")) {
-            item->setForeground(QColor(231, 76, 60)); // Red for failure
-        } else if (step.contains("🔍")) {
-            item->setForeground(QColor(52, 152, 219)); // Blue for search
-        } else if (step.contains("➕")) {
-            item->setForeground(QColor(46, 125, 50)); // Green for insert/put
-        } else if (step.contains("🗑️")) {
-            item->setForeground(QColor(211, 47, 47)); // Red for delete
-        } else if (step.contains("📊") || step.contains("🎯")) {
-            item->setForeground(QColor(155, 89, 182)); // Purple for calculation
-        } else {
-            item->setForeground(QColor(44, 62, 80)); // Default dark color
-        }
-
-        stepsList->addItem(item);
-    }
+    // The history only grows between clears, so only the rows appended
+    // since the last call reach the view; spilled rows page in on scroll
+    stepsModel->sync();
 
     // Auto-scroll to bottom to show latest steps
-    if (stepsList->count() > 0) {
-        stepsList->scrollToBottom();
-    }
+    stepsList->scrollToBottom();
 }
 
 void HashMapVisualization::showStats()
@@ -858,33 +1236,47 @@ void HashMapVisualization::showStats()
     // Update main area stats only
     sizeLabel->setText(QString("Size: %1").arg(hashMap->size()));
     bucketCountLabel->setText(QString("Buckets: %1").arg(hashMap->bucketCount()));
+
+    const HashDistribution distribution = hashMap->hashDistribution();
+    QString distributionText = QString("χ²: %1 (df %2) · Max chain: %3")
+                                   .arg(distribution.chiSquared, 0, 'f', 1)
+                                   .arg(distribution.degreesOfFreedom())
+                                   .arg(distribution.maxChain);
+    if (hashMap->getBackend() == HashMap::CUCKOO) {
+        // Lookups are bounded at two slots; the cost shows up on insert instead
+        distributionText += QString(" · Max kicks: %1").arg(hashMap->maxKickChain());
+    }
+    distributionLabel->setText(distributionText);
+
+    // Tracked chain-length histogram; cheap even for large tables
+    const QVector<int> histogram = hashMap->chainLengthHistogram();
+    QStringList histogramLines;
+    for (int length = 0; length < histogram.size(); ++length) {
+        if (histogram[length] > 0) histogramLines << QString("%1 → %2 buckets").arg(length).arg(histogram[length]);
+    }
+    distributionLabel->setToolTip(QString("Chi-squared of entries per home bucket against a uniform spread. "
+                                          "Close to df (buckets − 1) means the hash spreads keys evenly.\n\n"
+                                          "Length histogram (longest %1):\n%2")
+                                      .arg(hashMap->maxChainLength())
+                                      .arg(histogramLines.join("\n")));
     
-    // Update bucket note at bottom with display limitation message
+    // Update bucket note at bottom with the level of detail shown
     if (bucketNote) {
         int bucketCount = hashMap->bucketCount();
-        if (bucketCount > 16) {
-            bucketNote->setText(QString("* Maximum buckets shown: 16 (Due to screen size limitation. Actual buckets: %1)").arg(bucketCount));
-            bucketNote->setStyleSheet(R"(
-                QLabel {
-                    color: #e67e22;
-                    font-size: 11px;
-                    font-style: italic;
-                    font-weight: bold;
-                    padding: 5px;
-                    background-color: rgba(230, 126, 34, 0.1);
-                    border-radius: 5px;
-                }
-            )");
+        if (bucketCount > MAX_DETAIL_BUCKETS) {
+            if (overviewMode) {
+                bucketNote->setText(QString("* Heatmap of all %1 buckets, darker = longer. "
+                                            "Scroll up or click on a cell to see its buckets").arg(bucketCount));
+            } else {
+                bucketNote->setText(QString("* Buckets %1–%2 of %3. Shift+scroll to pan, scroll down for the heatmap")
+                                        .arg(firstShownBucket)
+                                        .arg(firstShownBucket + bucketItems.size() - 1)
+                                        .arg(bucketCount));
+            }
+            StyleManager::instance().setBucketNoteClipped(bucketNote, true);
         } else {
-            bucketNote->setText(QString("* Maximum buckets shown: 16 (Due to screen size limitation)"));
-            bucketNote->setStyleSheet(R"(
-                QLabel {
-                    color: #7f8c8d;
-                    font-size: 11px;
-                    font-style: italic;
-                    padding: 5px;
-                }
-            )");
+            bucketNote->setText(QString("* Buckets shown: all %1").arg(bucketCount));
+            StyleManager::instance().setBucketNoteClipped(bucketNote, false);
         }
     }
     
@@ -892,88 +1284,25 @@ void HashMapVisualization::showStats()
     float loadFactor = hashMap->loadFactor();
     QString loadFactorText = QString("Load Factor: %1").arg(loadFactor, 0, 'f', 2);
     
-    // Color coding: yellow when approaching threshold (>= 0.6), red when at/above threshold (>= 0.75)
-    QString colorStyle;
+    // Color coding: yellow when approaching threshold (>= 0.6), red when at/above threshold (>= 0.75).
+    // Both labels keep one stylesheet; only their state property changes.
+    StyleManager::LoadLevel level = StyleManager::LoadLevel::Normal;
     if (loadFactor >= 0.75f) {
-        // Red when at or above threshold
-        colorStyle = R"(
-            QLabel {
-                color: #ffffff;
-                font-weight: bold;
-                font-family: 'Segoe UI';
-                font-size: 12px;
-                padding: 8px 12px;
-                background-color: rgba(231, 76, 60, 0.9);
-                border-radius: 12px;
-                border: 1px solid rgba(192, 57, 43, 0.5);
-            }
-        )";
+        level = StyleManager::LoadLevel::Full;
     } else if (loadFactor >= 0.6f) {
-        // Yellow when approaching threshold
-        colorStyle = R"(
-            QLabel {
-                color: #856404;
-                font-weight: bold;
-                font-family: 'Segoe UI';
-                font-size: 12px;
-                padding: 8px 12px;
-                background-color: rgba(255, 193, 7, 0.9);
-                border-radius: 12px;
-                border: 1px solid rgba(255, 152, 0, 0.5);
-            }
-        )";
-    } else {
-        // Normal color when below threshold
-        colorStyle = R"(
-            QLabel {
-                color: #34495e;
-                font-weight: bold;
-                font-family: 'Segoe UI';
-                font-size: 12px;
-                padding: 8px 12px;
-                background-color: rgba(74, 144, 226, 0.1);
-                border-radius: 12px;
-                border: 1px solid rgba(74, 144, 226, 0.2);
-            }
-        )";
+        level = StyleManager::LoadLevel::NearlyFull;
     }
-    
+
     loadFactorLabel->setText(loadFactorText);
-    loadFactorLabel->setStyleSheet(colorStyle);
+    StyleManager::instance().setLoadLevel(loadFactorLabel, level);
     
     // Update warning label
-    if (loadFactor >= 0.75f) {
-        loadFactorWarning->setText("⚠️ FULL");
-        loadFactorWarning->setStyleSheet(R"(
-            QLabel {
-                color: #ffffff;
-                font-weight: bold;
-                font-family: 'Segoe UI';
-                font-size: 11px;
-                padding: 6px 10px;
-                background-color: rgba(231, 76, 60, 0.9);
-                border-radius: 10px;
-                border: 1px solid rgba(192, 57, 43, 0.5);
-            }
-        )");
-        loadFactorWarning->setVisible(true);
-    } else if (loadFactor >= 0.6f) {
-        loadFactorWarning->setText("⚠️ NEARLY FULL");
-        loadFactorWarning->setStyleSheet(R"(
-            QLabel {
-                color: #856404;
-                font-weight: bold;
-                font-family: 'Segoe UI';
-                font-size: 11px;
-                padding: 6px 10px;
-                background-color: rgba(255, 193, 7, 0.9);
-                border-radius: 10px;
-                border: 1px solid rgba(255, 152, 0, 0.5);
-            }
-        )");
-        loadFactorWarning->setVisible(true);
-    } else {
+    if (level == StyleManager::LoadLevel::Normal) {
         loadFactorWarning->setVisible(false);
+    } else {
+        loadFactorWarning->setText(level == StyleManager::LoadLevel::Full ? "⚠️ FULL" : "⚠️ NEARLY FULL");
+        StyleManager::instance().setLoadLevel(loadFactorWarning, level);
+        loadFactorWarning->setVisible(true);
     }
 }
 
@@ -996,8 +1325,11 @@ void HashMapVisualization::onTypeChanged()
     HashMap::DataType keyType = static_cast<HashMap::DataType>(keyTypeCombo->currentIndex());
     HashMap::DataType valueType = static_cast<HashMap::DataType>(valueTypeCombo->currentIndex());
 
+    HashMap::Backend backend = static_cast<HashMap::Backend>(backendCombo->currentIndex());
+
     hashMap->setKeyType(keyType);
     hashMap->setValueType(valueType);
+    hashMap->setBackend(backend);
 
     // Update input placeholders based on selected types
     QString keyPlaceholder = QString("Enter %1 key").arg(HashMap::dataTypeToString(keyType).toLower());
@@ -1012,6 +1344,26 @@ void HashMapVisualization::onTypeChanged()
     updateStepTrace();
 }
 
+void HashMapVisualization::onHashStrategyChanged(int index)
+{
+    // Unlike a type or storage change the contents are kept: the map
+    // rehashes every key in place so the distributions can be compared
+    const auto kind = static_cast<HashStrategy::Kind>(hashCombo->itemData(index).toInt());
+    hashMap->setHashStrategy(HashStrategy(kind));
+    updateVisualization();
+    updateStepTrace();
+}
+
+void HashMapVisualization::onReducerChanged(int index)
+{
+    // Contents are kept; the table is rebuilt under the new bucket indices
+    HashMapGrowthPolicy policy = hashMap->growthPolicy();
+    policy.reducer = static_cast<HashMapBucketReducer>(index);
+    hashMap->setGrowthPolicy(policy);
+    updateVisualization();
+    updateStepTrace();
+}
+
 QVariant HashMapVisualization::convertStringToVariant(const QString &str, HashMap::DataType type)
 {
     bool ok;
@@ -1149,25 +1501,22 @@ void HashMapVisualization::animateSearchResult(const QString &key, bool found)
             highlightRect = nullptr;
         }
 
-        // Create highlight rectangle for the target bucket
-        const int bucketCount = hashMap->bucketCount();
-        const int totalWidth = bucketCount * (BUCKET_WIDTH + BUCKET_SPACING) - BUCKET_SPACING;
-        const int startX = -totalWidth / 2;
-        const int x = startX + bucketIndex * (BUCKET_WIDTH + BUCKET_SPACING);
-        const int y = 0;
-
-        // Calculate bucket height (same logic as drawBuckets)
-        const QVector<QVector<QPair<QVariant, QVariant>>> bucketContents = hashMap->getBucketContents();
-        int bucketHeight = BUCKET_HEIGHT;
-        if (bucketIndex < bucketContents.size() && !bucketContents[bucketIndex].isEmpty()) {
-            bucketHeight = BUCKET_HEIGHT + (bucketContents[bucketIndex].size() * 30);
+        // Bring the target bucket on screen when zoomed in on other buckets
+        if (!overviewMode && bucketSceneRect(bucketIndex).isNull()) {
+            setOverview(false, bucketIndex);
+            drawBuckets();
+            showStats();
         }
 
-        // Create highlight effect (like Binary Search Tree node highlighting)
-        highlightRect = scene->addRect(x - 3, y - 3, BUCKET_WIDTH + 6, bucketHeight + 6,
-                                       QPen(found ? QColor(40, 167, 69, 200) : QColor(220, 53, 69, 200), 4),
-                                       QBrush(Qt::transparent));
-        highlightRect->setZValue(10);
+        // Create highlight rectangle around the target bucket box or heatmap cell
+        // (like Binary Search Tree node highlighting)
+        const QRectF target = bucketSceneRect(bucketIndex);
+        if (!target.isNull()) {
+            highlightRect = scene->addRect(target.adjusted(-3, -3, 3, 3),
+                                           QPen(found ? QColor(40, 167, 69, 200) : QColor(220, 53, 69, 200), 4),
+                                           QBrush(Qt::transparent));
+            highlightRect->setZValue(10);
+        }
 
         QTimer::singleShot(800, [this, key, found]() {
             // Step 3: Show search result
@@ -1250,69 +1599,216 @@ void HashMapVisualization::onClearClicked()
 
 void HashMapVisualization::onRandomizeClicked()
 {
-    // Generate a single random value based on selected types
+    const int count = randomCountCombo->currentData().toInt();
     HashMap::DataType keyType = hashMap->getKeyType();
     HashMap::DataType valueType = hashMap->getValueType();
 
-    // Generate only one random value
-    {
-        QVariant key, value;
-
-        // Generate random key based on type
-        switch (keyType) {
-        case HashMap::STRING: {
-            QStringList keys = {"apple", "banana", "cherry", "date", "fig", "grape", "kiwi", "lemon"};
-            key = keys[QRandomGenerator::global()->bounded(keys.size())];
-            break;
-        }
-        case HashMap::INTEGER:
-            key = QRandomGenerator::global()->bounded(1, 100);
-            break;
-        case HashMap::DOUBLE:
-            key = QRandomGenerator::global()->generateDouble() * 100.0;
-            break;
-        case HashMap::FLOAT:
-            key = static_cast<float>(QRandomGenerator::global()->generateDouble() * 100.0f);
-            break;
-        case HashMap::CHAR: {
-            const QString alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
-            int idx = QRandomGenerator::global()->bounded(alphabet.size());
-            key = QVariant(QChar(alphabet.at(idx)));
-            break;
-        }
-        }
-
-        // Generate random value based on type
-        switch (valueType) {
-        case HashMap::STRING: {
-            QStringList values = {"red", "blue", "green", "yellow", "purple", "orange", "pink", "brown"};
-            value = values[QRandomGenerator::global()->bounded(values.size())];
-            break;
-        }
-        case HashMap::INTEGER:
-            value = QRandomGenerator::global()->bounded(1, 1000);
-            break;
-        case HashMap::DOUBLE:
-            value = QRandomGenerator::global()->generateDouble() * 1000.0;
-            break;
-        case HashMap::FLOAT:
-            value = static_cast<float>(QRandomGenerator::global()->generateDouble() * 1000.0f);
-            break;
-        case HashMap::CHAR: {
-            const QString alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
-            int idx = QRandomGenerator::global()->bounded(alphabet.size());
-            value = QVariant(QChar(alphabet.at(idx)));
-            break;
-        }
+    if (count <= 1) {
+        // A single pair goes through put() so every step is traced
+        hashMap->put(randomKey(keyType, 1), randomValue(valueType));
+    } else {
+        // Bulk path: one presized batch instead of count separate puts
+        QVector<QVariant> keys;
+        QVector<QVariant> values;
+        keys.reserve(count);
+        values.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            keys.push_back(randomKey(keyType, count));
+            values.push_back(randomValue(valueType));
         }
-
-        hashMap->put(key, value);
+        hashMap->putBatch(keys, values);
     }
 
     animateOperation("Randomize");
     showAlgorithm("Randomize");
 }
 
+void HashMapVisualization::onSaveClicked()
+{
+    const QString path = QFileDialog::getSaveFileName(this, "Save HashMap Snapshot", QString(),
+                                                      "HashMap snapshots (*.hmsnap);;All files (*)");
+    if (path.isEmpty()) return;
+
+    QString error;
+    if (!hashMap->saveSnapshot(path, &error)) {
+        QMessageBox::warning(this, "Save Snapshot", error);
+    }
+}
+
+void HashMapVisualization::onOpenClicked()
+{
+    const QString path = QFileDialog::getOpenFileName(this, "Open HashMap Snapshot", QString(),
+                                                      "HashMap snapshots (*.hmsnap);;All files (*)");
+    if (path.isEmpty()) return;
+
+    HashMapSnapshot snapshot;
+    QString error;
+    if (!snapshot.open(path, &error)) {
+        QMessageBox::warning(this, "Open Snapshot", error);
+        return;
+    }
+    hashMap->loadSnapshot(snapshot);
+
+    // Follow the snapshot's types and hash without triggering the clear in
+    // onTypeChanged
+    const QSignalBlocker keyBlocker(keyTypeCombo);
+    const QSignalBlocker valueBlocker(valueTypeCombo);
+    const QSignalBlocker hashBlocker(hashCombo);
+    keyTypeCombo->setCurrentIndex(snapshot.keyType());
+    valueTypeCombo->setCurrentIndex(snapshot.valueType());
+    hashCombo->setCurrentIndex(hashCombo->findData(static_cast<int>(snapshot.hashStrategy().kind())));
+    keyInput->setPlaceholderText(QString("Enter %1 key").arg(HashMap::dataTypeToString(snapshot.keyType()).toLower()));
+    valueInput->setPlaceholderText(QString("Enter %1 value").arg(HashMap::dataTypeToString(snapshot.valueType()).toLower()));
+
+    animateOperation("Open");
+    showAlgorithm("Open");
+}
+
+void HashMapVisualization::onImportClicked()
+{
+    if (importTimer->isActive()) {
+        // Stop keeps the rows inserted so far
+        importer->stop();
+        finishImport();
+        return;
+    }
+
+    const QString path = QFileDialog::getOpenFileName(this, "Import Key/Value File", QString(),
+                                                      "Key/value files (*.csv *.tsv *.txt);;All files (*)");
+    if (path.isEmpty()) return;
+
+    HashMapFileLoader::Options options;
+    options.keyType = hashMap->getKeyType();
+    options.valueType = hashMap->getValueType();
+    QString error;
+    if (!importer->start(path, options, &error)) {
+        QMessageBox::warning(this, "Import", error);
+        return;
+    }
+
+    hashMap->addStepToHistory(QString("📂 Importing %1 as %2 → %3")
+                                  .arg(QFileInfo(path).fileName())
+                                  .arg(HashMap::dataTypeToString(options.keyType))
+                                  .arg(HashMap::dataTypeToString(options.valueType)));
+    updateStepTrace();
+    importedRows = 0;
+    importedKeys = 0;
+    setImporting(true);
+    importRedraw.start();
+    importTimer->start();
+}
+
+void HashMapVisualization::drainImport()
+{
+    // Parsed chunks wait in the loader; insert for one slice, then let the
+    // event loop run
+    QElapsedTimer slice;
+    slice.start();
+    HashMapFileLoader::Chunk chunk;
+    while (slice.elapsed() < IMPORT_SLICE_MS && importer->takeChunk(&chunk)) {
+        importedKeys += hashMap->putBatch(chunk.keys, chunk.values);
+        importedRows += chunk.keys.size();
+    }
+
+    const qint64 total = qMax<qint64>(1, importer->totalBytes());
+    const qint64 elapsed = qMax<qint64>(1, importer->elapsedMs());
+    const qint64 rows = importedRows;
+    importProgress->setValue(static_cast<int>(importer->bytesRead() * 1000 / total));
+    importProgress->setFormat(QString("%1%  ·  %2 rows  ·  %3 rows/s  ·  %4 MB/s")
+                                  .arg(importer->bytesRead() * 100 / total)
+                                  .arg(rows)
+                                  .arg(rows * 1000 / elapsed)
+                                  .arg(importer->bytesRead() / 1000.0 / elapsed, 0, 'f', 1));
+
+    if (importer->isDone()) {
+        finishImport();
+    } else if (importRedraw.elapsed() >= IMPORT_REDRAW_MS) {
+        updateVisualization();
+        importRedraw.start();
+    }
+}
+
+void HashMapVisualization::finishImport()
+{
+    importTimer->stop();
+
+    const QString error = importer->error();
+    if (!error.isEmpty()) {
+        hashMap->addStepToHistory(QString("❌ Import stopped: %1").arg(error));
+    }
+    hashMap->addStepToHistory(QString("✅ Imported %1 rows (%2 new keys) in %3 ms, %4 skipped (missing fields or wrong type)")
+                                  .arg(importedRows)
+                                  .arg(importedKeys)
+                                  .arg(importer->elapsedMs())
+                                  .arg(importer->rowsSkipped()));
+
+    setImporting(false);
+    animateOperation("Import");
+    showAlgorithm("Import");
+}
+
+void HashMapVisualization::setImporting(bool importing)
+{
+    // Everything that would write to the map or rebuild it waits for the import
+    const QList<QWidget *> controls = {keyInput, valueInput, insertButton, searchButton, deleteButton,
+                                       clearButton, randomizeButton, randomCountCombo, saveButton,
+                                       openButton, keyTypeCombo, valueTypeCombo, backendCombo,
+                                       hashCombo, reducerCombo};
+    for (QWidget *control : controls) {
+        control->setEnabled(!importing);
+    }
+    importButton->setText(importing ? "Stop" : "Import");
+    importProgress->setValue(0);
+    importProgress->setVisible(importing);
+}
+
+// Keys are drawn from a range that grows with count so large batches
+// still produce mostly distinct keys
+QVariant HashMapVisualization::randomKey(HashMap::DataType type, int count) const
+{
+    QRandomGenerator *rng = QRandomGenerator::global();
+    switch (type) {
+    case HashMap::STRING: {
+        const QStringList keys = {"apple", "banana", "cherry", "date", "fig", "grape", "kiwi", "lemon"};
+        const QString &key = keys[rng->bounded(keys.size())];
+        return count <= 1 ? QVariant(key) : QVariant(key + QString::number(rng->bounded(count * 4)));
+    }
+    case HashMap::INTEGER:
+        return rng->bounded(1, qMax(100, count * 10));
+    case HashMap::DOUBLE:
+        return rng->generateDouble() * qMax(100.0, count * 10.0);
+    case HashMap::FLOAT:
+        return static_cast<float>(rng->generateDouble() * qMax(100.0, count * 10.0));
+    case HashMap::CHAR: {
+        const QString alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        return QVariant(QChar(alphabet.at(rng->bounded(alphabet.size()))));
+    }
+    }
+    return QVariant();
+}
+
+QVariant HashMapVisualization::randomValue(HashMap::DataType type) const
+{
+    QRandomGenerator *rng = QRandomGenerator::global();
+    switch (type) {
+    case HashMap::STRING: {
+        const QStringList values = {"red", "blue", "green", "yellow", "purple", "orange", "pink", "brown"};
+        return values[rng->bounded(values.size())];
+    }
+    case HashMap::INTEGER:
+        return rng->bounded(1, 1000);
+    case HashMap::DOUBLE:
+        return rng->generateDouble() * 1000.0;
+    case HashMap::FLOAT:
+        return static_cast<float>(rng->generateDouble() * 1000.0f);
+    case HashMap::CHAR: {
+        const QString alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        return QVariant(QChar(alphabet.at(rng->bounded(alphabet.size()))));
+    }
+    }
+    return QVariant();
+}
+
 void HashMapVisualization::showAlgorithm(const QString &operation)
 {
     // Keep history in algorithm page similar to Steps: append entries, don't clear
@@ -1328,6 +1824,13 @@ void HashMapVisualization::showAlgorithm(const QString &operation)
         algorithmList->addItem(separator);
     }
 
+    QString indexLine = "2. Find bucket index: hash % bucket_count";
+    if (hashMap->growthPolicy().reducer == HashMapBucketReducer::Mask) {
+        indexLine = "2. Find bucket index: mix(hash) & (bucket_count - 1)";
+    } else if (hashMap->growthPolicy().reducer == HashMapBucketReducer::FastRange) {
+        indexLine = "2. Find bucket index: (mix(hash) × bucket_count) >> 64";
+    }
+
     if (operation == "Insert" || operation == "Put") {
         QStringList lines = {
             "🔧 HashMap Insert Algorithm",
@@ -1337,7 +1840,7 @@ void HashMapVisualization::showAlgorithm(const QString &operation)
             "",
             "🔄 Steps:",
             "1. Calculate hash value: hash(key)",
-            "2. Find bucket index: hash % bucket_count",
+            indexLine,
             "3. Navigate to the bucket",
             "4. Search through the chain:",
             "   • If key exists: update value",
@@ -1385,7 +1888,7 @@ void HashMapVisualization::showAlgorithm(const QString &operation)
             "",
             "🔄 Steps:",
             "1. Calculate hash value: hash(key)",
-            "2. Find bucket index: hash % bucket_count",
+            indexLine,
             "3. Navigate to the bucket",
             "4. Traverse the chain:",
             "   • Compare each key with target",
@@ -1430,7 +1933,7 @@ void HashMapVisualization::showAlgorithm(const QString &operation)
             "",
             "🔄 Steps:",
             "1. Calculate hash value: hash(key)",
-            "2. Find bucket index: hash % bucket_count",
+            indexLine,
             "3. Navigate to the bucket",
             "4. Search through the chain:",
             "   • Compare each key with target",
@@ -1518,15 +2021,17 @@ void HashMapVisualization::showAlgorithm(const QString &operation)
             "💾 Space Complexity: O(k)",
             "",
             "🔄 Steps:",
-            "1. Generate random key-value pairs",
+            "1. Generate N random key-value pairs (N from the ×N box)",
             "2. For each pair:",
             "   • Create key based on selected type",
             "   • Create value based on selected type",
-            "   • Insert using standard insert algorithm",
+            "3. N = 1: insert using standard put algorithm",
+            "   N > 1: batch put — presize once, hash all keys,",
+            "   prefetch buckets ahead, then insert",
             "",
             "📊 Sample Data Types:",
             "   • Strings: fruit names, colors",
-            "   • Integers: random numbers 1-100",
+            "   • Integers: random numbers 1-100 (wider range when N > 1)",
             "   • Doubles/Floats: random decimals"
         };
         
@@ -1555,6 +2060,100 @@ void HashMapVisualization::showAlgorithm(const QString &operation)
                 item->setForeground(QColor("#6c757d"));
             }
             
+            algorithmList->addItem(item);
+        }
+    } else if (operation == "Open") {
+        QStringList lines = {
+            "📂 HashMap Snapshot Restore",
+            "",
+            "⏰ Time Complexity: O(n) to restore, O(1) per lookup in the file",
+            "💾 Space Complexity: O(1) beyond the mapped file",
+            "",
+            "🔄 Steps:",
+            "1. Map the file into memory (no parsing pass)",
+            "2. Check magic, version, byte order and section bounds",
+            "3. Adopt the snapshot's key/value types and hash function",
+            "4. Presize the table for the stored entry count",
+            "5. Insert every row through the batch put",
+            "",
+            "📊 File Layout:",
+            "   • Rows grouped by bucket (hash masked to a power of two)",
+            "   • Stored hashes reject most non-matching rows",
+            "   • Strings point into a shared UTF-16 blob"
+        };
+
+        for (const QString &line : lines) {
+            QListWidgetItem *item = new QListWidgetItem(line);
+
+            if (line.startsWith("📂")) {
+                QFont titleFont = item->font();
+                titleFont.setBold(true);
+                titleFont.setPointSize(14);
+                item->setFont(titleFont);
+                item->setForeground(QColor("#7b4fff"));
+            } else if (line.startsWith("⏰") || line.startsWith("💾")) {
+                QFont complexityFont = item->font();
+                complexityFont.setBold(true);
+                item->setFont(complexityFont);
+                item->setForeground(QColor("#28a745"));
+            } else if (line.startsWith("🔄") || line.startsWith("📊")) {
+                QFont stepsFont = item->font();
+                stepsFont.setBold(true);
+                item->setFont(stepsFont);
+                item->setForeground(QColor("#007bff"));
+            } else if (line.contains(". ") || line.contains("• ")) {
+                item->setForeground(QColor("#495057"));
+            } else {
+                item->setForeground(QColor("#6c757d"));
+            }
+
+            algorithmList->addItem(item);
+        }
+    } else if (operation == "Import") {
+        QStringList lines = {
+            "📥 HashMap File Import",
+            "",
+            "⏰ Time Complexity: O(n) for n rows, in batches",
+            "💾 Space Complexity: O(chunk) beyond the table",
+            "",
+            "🔄 Steps:",
+            "1. A worker thread reads the file in 1 MiB blocks",
+            "2. Each line is split on tab or comma in place",
+            "3. Key and value are converted to the selected types",
+            "4. Rows are queued in chunks of 16k; the reader waits when the queue is full",
+            "5. The GUI thread inserts chunks through the batch put",
+            "   for a short slice per tick, so the page stays responsive",
+            "",
+            "📊 Skipped Rows:",
+            "   • Headers and other rows that do not convert",
+            "   • Rows with an empty key or value"
+        };
+
+        for (const QString &line : lines) {
+            QListWidgetItem *item = new QListWidgetItem(line);
+
+            if (line.startsWith("📥")) {
+                QFont titleFont = item->font();
+                titleFont.setBold(true);
+                titleFont.setPointSize(14);
+                item->setFont(titleFont);
+                item->setForeground(QColor("#7b4fff"));
+            } else if (line.startsWith("⏰") || line.startsWith("💾")) {
+                QFont complexityFont = item->font();
+                complexityFont.setBold(true);
+                item->setFont(complexityFont);
+                item->setForeground(QColor("#28a745"));
+            } else if (line.startsWith("🔄") || line.startsWith("📊")) {
+                QFont stepsFont = item->font();
+                stepsFont.setBold(true);
+                item->setFont(stepsFont);
+                item->setForeground(QColor("#007bff"));
+            } else if (line.contains(". ") || line.contains("• ")) {
+                item->setForeground(QColor("#495057"));
+            } else {
+                item->setForeground(QColor("#6c757d"));
+            }
+
             algorithmList->addItem(item);
         }
     }
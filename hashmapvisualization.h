@@ -14,6 +14,9 @@
 #include <QGraphicsRectItem>
 #include <QGraphicsTextItem>
 #include <QGraphicsPathItem>
+#include <QGraphicsPixmapItem>
+#include <QWheelEvent>
+#include <QMouseEvent>
 #include <QPainterPath>
 #include <QTimer>
 #include <QPropertyAnimation>
@@ -34,8 +37,16 @@
 #include <QGraphicsDropShadowEffect>
 #include <QScrollBar>
 #include <QSplitterHandle>
+#include <QThread>
+#include <QFileDialog>
+#include <QProgressBar>
+#include <QElapsedTimer>
 #include <memory>
 #include "hashmap.h"
+#include "hashmapheatmap.h"
+#include "steplistmodel.h"
+#include "concurrentworkload.h"
+#include "hashmaploader.h"
 #include "backbutton.h"
 #include "stylemanager.h"
 #include "widgetmanager.h"
@@ -53,6 +64,7 @@ signals:
 
 protected:
     void paintEvent(QPaintEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
 
 private slots:
     void onBackClicked();
@@ -61,9 +73,17 @@ private slots:
     void onDeleteClicked();
     void onClearClicked();
     void onRandomizeClicked();
+    void onSaveClicked();
+    void onOpenClicked();
+    void onImportClicked();
+    void drainImport();
     void onTypeChanged();
+    void onHashStrategyChanged(int index);
+    void onReducerChanged(int index);
     void updateVisualization();
     void updateStepTrace();
+    void onRunWorkloadClicked();
+    void updateShardOccupancy();
 
 private:
     void setupUI();
@@ -71,15 +91,25 @@ private:
     void setupRightPanel();
     void setupTypeSelection();
     void setupStatsAndControls();
-    void setupStepTrace();
     void setupStepTraceTop();
+    QWidget *createConcurrencyTab();
     void drawBuckets();
+    void buildBucketItems(int shownBuckets);
+    void updateBucketItems(int bucket);
+    void drawHeatmap();
+    void setOverview(bool overview, int centerBucket = 0);
+    QRectF bucketSceneRect(int bucket) const;
+    int bucketHeightFor(int shownEntries, int hiddenEntries) const;
     void animateOperation(const QString &operation);
     void animateSearchResult(const QString &key, bool found);
     void showAlgorithm(const QString &operation);
     void showStats();
     void zoomToFit();
+    void finishImport();
+    void setImporting(bool importing);
     QVariant convertStringToVariant(const QString &str, HashMap::DataType type);
+    QVariant randomKey(HashMap::DataType type, int count) const;
+    QVariant randomValue(HashMap::DataType type) const;
 
     // UI Components
     QSplitter *mainSplitter;
@@ -99,6 +129,9 @@ private:
     QGroupBox *typeGroup;
     QComboBox *keyTypeCombo;
     QComboBox *valueTypeCombo;
+    QComboBox *backendCombo;
+    QComboBox *hashCombo;  // hash function; switching rehashes without clearing
+    QComboBox *reducerCombo;  // hash → bucket index reduction (modulo, mask, fastrange)
     // Controls
     QLineEdit *keyInput;
     QLineEdit *valueInput;
@@ -107,24 +140,71 @@ private:
     QPushButton *deleteButton;
     QPushButton *clearButton;
     QPushButton *randomizeButton;
+    QComboBox *randomCountCombo;  // pairs per Random click; more than one uses the batch API
+    QPushButton *saveButton;  // binary snapshot of the contents (hashmapsnapshot.h)
+    QPushButton *openButton;
+    QPushButton *importButton;  // CSV/TSV bulk load; reads as Stop while loading
+    QProgressBar *importProgress;
     // Stats (main area only)
     QLabel *sizeLabel;
     QLabel *bucketCountLabel;
     QLabel *loadFactorLabel;
     QLabel *loadFactorWarning;  // Warning label for load factor status
+    QLabel *distributionLabel;  // chi-squared and max chain of the home buckets
     QLabel *bucketNote;
 
     // Step trace with tabs
     QGroupBox *traceGroup;
     QTabWidget *traceTabWidget;
-    QListWidget *stepsList;
+    QListView *stepsList;
+    StepListModel *stepsModel;
     QListWidget *algorithmList;
+    // Threads tab: multi-threaded ConcurrentHashMap workload
+    QComboBox *threadCountCombo;
+    QPushButton *workloadButton;
+    QLabel *workloadStatus;
+    QListWidget *shardList;
+    QTimer *workloadTimer;
+    ConcurrentWorkload *workload;
+
+    // File import: the loader parses on its own thread and importTimer feeds
+    // its chunks to putBatch a time slice at a time
+    QTimer *importTimer;
+    HashMapFileLoader *importer;
+    QElapsedTimer importRedraw;  // since the table was last redrawn during an import
+    qint64 importedRows;
+    qint64 importedKeys;  // rows that added a new key rather than replacing a value
 
     // Data and visualization
     HashMap *hashMap;
-    QVector<QGraphicsRectItem*> bucketRects;
-    QVector<QGraphicsTextItem*> bucketTexts;
-    QVector<QVector<QGraphicsTextItem*>> chainTexts;
+
+    // Retained scene: each shown bucket owns a frame whose labels and entry
+    // items are its children, so an operation only touches the buckets the
+    // map reports dirty. Entry items are created on first use and hidden
+    // when the chain shortens.
+    struct BucketItems {
+        QGraphicsPathItem *frame = nullptr;
+        QGraphicsTextItem *moreText = nullptr;
+        QGraphicsTextItem *emptyText = nullptr;
+        QVector<QGraphicsPathItem*> entryBackgrounds;
+        QVector<QGraphicsTextItem*> entryTexts;
+        QVector<QGraphicsTextItem*> arrows;  // arrows[j] links entry j to entry j + 1
+    };
+    QVector<BucketItems> bucketItems;
+    QGraphicsTextItem *vizTitle;
+
+    // Level of detail: tables past MAX_DETAIL_BUCKETS start zoomed out as a
+    // heatmap; zooming in shows bucket boxes from firstShownBucket on
+    HashMapHeatmap heatmap;
+    QGraphicsPixmapItem *heatmapItem;
+    bool overviewMode;
+    bool layoutStale;     // mode or window changed since the last draw
+    int firstShownBucket;
+    QFont indexFont;
+    QFont entryFont;
+    QFont arrowFont;
+    QFont moreFont;
+    QFont emptyFont;
 
     // Animation
     QTimer *animationTimer;
@@ -133,12 +213,18 @@ private:
     // Track previous bucket count for zoom detection
     int previousBucketCount;
 
+
     // Constants
     static const int BUCKET_WIDTH;
     static const int BUCKET_HEIGHT;
     static const int BUCKET_SPACING;
     static const int CHAIN_ITEM_HEIGHT;
     static const int MAX_VISIBLE_BUCKETS;
+    static const int MAX_ENTRIES_PER_BUCKET;  // chain entries drawn per bucket
+    static const int MAX_DETAIL_BUCKETS;      // bucket boxes drawn when zoomed in
+    static const int HEATMAP_WIDTH;           // scene width of the zoomed-out heatmap
+    static const int IMPORT_SLICE_MS;         // GUI time per tick spent inserting imported rows
+    static const int IMPORT_REDRAW_MS;        // table redraw interval while importing
 };
 
 #endif // HASHMAPVISUALIZATION_H
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+#include <cstddef>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// Full 128-bit product of two 64-bit values
+inline void multiply128(quint64 a, quint64 b, quint64 &low, quint64 &high) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    low = static_cast<quint64>(product);
+    high = static_cast<quint64>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    low = _umul128(a, b, &high);
+#else
+    const quint64 aLow = a & 0xFFFFFFFFu, aHigh = a >> 32;
+    const quint64 bLow = b & 0xFFFFFFFFu, bHigh = b >> 32;
+    const quint64 lowLow = aLow * bLow, lowHigh = aLow * bHigh;
+    const quint64 highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+    const quint64 middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFu) + (highLow & 0xFFFFFFFFu);
+    high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    low = a * b;
+#endif
+}
+
+// Hash function applied on top of the per-type base hash from HashMapTraits
+// (std::hash for numbers and chars, std::hash over the UTF-16 buffer for
+// strings). Chosen at runtime so the visualizer can compare them on the same
+// keys; switching rehashes the table.
+class HashStrategy {
+public:
+    enum Kind {
+        STD_HASH,       // base hash unchanged (identity for ints with libstdc++)
+        WY_MIX,         // wyhash's 128-bit multiply-fold mixer
+        MULTIPLY_SHIFT  // seeded multiply-add-shift (Dietzfelbinger)
+    };
+
+    static constexpr quint64 DefaultSeed = 0x2545F4914F6CDD1Dull;
+
+    explicit HashStrategy(Kind kind = STD_HASH, quint64 seed = DefaultSeed)
+        : kind_(kind), seed_(seed) {
+        // Multiply-shift needs an odd multiplier; derive the 128-bit
+        // constants from the seed so different seeds give independent functions
+        quint64 state = seed;
+        multiplierLow_ = splitMix(state) | 1u;
+        multiplierHigh_ = splitMix(state);
+        incrementLow_ = splitMix(state);
+        incrementHigh_ = splitMix(state);
+    }
+
+    Kind kind() const { return kind_; }
+    quint64 seed() const { return seed_; }
+
+    size_t apply(size_t base) const {
+        const quint64 x = static_cast<quint64>(base);
+        switch (kind_) {
+        case WY_MIX:
+            return static_cast<size_t>(multiplyFold(x ^ 0xA0761D6478BD642Full, x ^ seed_ ^ 0xE7037ED1A0B428DBull));
+        case MULTIPLY_SHIFT:
+            // The high 64 bits of a*x + b mod 2^128 are the well-mixed part,
+            // so bucket reducers that read the top bits see all of them
+            return static_cast<size_t>(multiplyAddShift(x));
+        case STD_HASH:
+        default:
+            return base;
+        }
+    }
+
+    bool operator==(const HashStrategy &other) const { return kind_ == other.kind_ && seed_ == other.seed_; }
+    bool operator!=(const HashStrategy &other) const { return !(*this == other); }
+
+    static QString name(Kind kind) {
+        switch (kind) {
+        case STD_HASH: return "std::hash";
+        case WY_MIX: return "wyhash mix";
+        case MULTIPLY_SHIFT: return "Multiply-shift";
+        }
+        return "Unknown";
+    }
+
+private:
+    Kind kind_;
+    quint64 seed_;
+    quint64 multiplierLow_;
+    quint64 multiplierHigh_;
+    quint64 incrementLow_;
+    quint64 incrementHigh_;
+
+    static quint64 splitMix(quint64 &state) {
+        quint64 z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // (a*x + b) >> 64 with 128-bit a and b, computed in 64-bit halves
+    quint64 multiplyAddShift(quint64 x) const {
+        quint64 low = 0, high = 0;
+        multiply128(multiplierLow_, x, low, high);
+        const quint64 sum = low + incrementLow_;
+        const quint64 carry = sum < low ? 1u : 0u;
+        return high + multiplierHigh_ * x + incrementHigh_ + carry;
+    }
+
+    // Low and high halves of the 128-bit product, xored together
+    static quint64 multiplyFold(quint64 a, quint64 b) {
+        quint64 low = 0, high = 0;
+        multiply128(a, b, low, high);
+        return low ^ high;
+    }
+};
+
+// How evenly a table's entries spread over their home buckets
+struct HashDistribution {
+    int entries = 0;
+    int buckets = 0;
+    double chiSquared = 0.0;  // sum of (count - n/m)^2 / (n/m) over home buckets
+    int maxChain = 0;         // most entries sharing one home bucket
+
+    // For uniform hashing chi-squared is close to m - 1 (the degrees of
+    // freedom); much larger means clustering
+    int degreesOfFreedom() const { return std::max(0, buckets - 1); }
+
+    // counts[i] = number of entries whose home bucket is i
+    static HashDistribution fromCounts(const QVector<int> &counts) {
+        HashDistribution d;
+        d.buckets = counts.size();
+        for (int c : counts) {
+            d.entries += c;
+            d.maxChain = std::max(d.maxChain, c);
+        }
+        if (d.entries == 0 || d.buckets == 0) return d;
+
+        const double expected = static_cast<double>(d.entries) / d.buckets;
+        for (int c : counts) {
+            const double diff = c - expected;
+            d.chiSquared += diff * diff / expected;
+        }
+        return d;
+    }
+};
@@ -8,6 +8,7 @@
 #include "treeinsertion.h"
 #include "graphvisualization.h"
 #include "hashmapvisualization.h"
+#include "radixtreevisualization.h"
 #include "redblacktree.h"
 #include "widgetmanager.h"
 
@@ -36,6 +37,7 @@ int main(int argc, char *argv[])
     TreeInsertion *currentTreeInsertion = nullptr;
     GraphVisualization *currentGraphVisualization = nullptr;
     HashMapVisualization *currentHashMapVisualization = nullptr;
+    RadixTreeVisualization *currentRadixTreeVisualization = nullptr;
     RedBlackTree *currentRedBlackTree = nullptr;
     int theoryPageIndex = -1;
     int visualizationPageIndex = -1;
@@ -50,7 +52,8 @@ int main(int argc, char *argv[])
     QObject::connect(menuPage, &MenuPage::dataStructureSelected,
                      [mainWindow, menuPageIndex, &currentTheoryPage, &theoryPageIndex,
                       &currentDataStructure, &currentTreeInsertion, &currentGraphVisualization,
-                      &currentHashMapVisualization, &currentRedBlackTree, &visualizationPageIndex](const QString &dsName) {
+                      &currentHashMapVisualization, &currentRadixTreeVisualization, &currentRedBlackTree,
+                      &visualizationPageIndex](const QString &dsName) {
                          // Store current data structure
                          currentDataStructure = dsName;
 
@@ -76,7 +79,7 @@ int main(int argc, char *argv[])
                         QObject::connect(currentTheoryPage, &TheoryPage::tryItYourself,
                                          [mainWindow, theoryPageIndex, currentDataStructure, &currentTheoryPage,
                                           &currentTreeInsertion, &currentGraphVisualization, &currentHashMapVisualization, 
-                                          &currentRedBlackTree, &visualizationPageIndex]() mutable {
+                                          &currentRadixTreeVisualization, &currentRedBlackTree, &visualizationPageIndex]() mutable {
                                               // Safe cleanup using widget manager
                                               if (currentTreeInsertion) {
                                                   mainWindow->removeWidget(currentTreeInsertion);
@@ -96,6 +99,15 @@ int main(int argc, char *argv[])
                                                   }
                                                   currentHashMapVisualization = nullptr;
                                               }
+                                              if (currentRadixTreeVisualization) {
+                                                  mainWindow->removeWidget(currentRadixTreeVisualization);
+                                                  if (g_widgetManager) {
+                                                      g_widgetManager->safeDeleteLater(currentRadixTreeVisualization);
+                                                  } else {
+                                                      currentRadixTreeVisualization->deleteLater();
+                                                  }
+                                                  currentRadixTreeVisualization = nullptr;
+                                              }
                                               if (currentRedBlackTree) {
                                                   mainWindow->removeWidget(currentRedBlackTree);
                                                   if (g_widgetManager) {
@@ -166,6 +178,22 @@ int main(int argc, char *argv[])
                                                                        }
                                                                    });
 
+                                                  mainWindow->setCurrentIndex(visualizationPageIndex);
+                                              } else if (currentDataStructure == "Radix Tree") {
+                                                  currentRadixTreeVisualization = new RadixTreeVisualization();
+                                                  visualizationPageIndex = mainWindow->addWidget(currentRadixTreeVisualization);
+
+                                                  // Use dynamic theory page index lookup
+                                                  QObject::connect(currentRadixTreeVisualization, &RadixTreeVisualization::backToOperations,
+                                                                   [mainWindow, &currentTheoryPage]() {
+                                                                       if (currentTheoryPage) {
+                                                                           int idx = mainWindow->indexOf(currentTheoryPage);
+                                                                           if (idx >= 0 && idx < mainWindow->count()) {
+                                                                               mainWindow->setCurrentIndex(idx);
+                                                                           }
+                                                                       }
+                                                                   });
+
                                                   mainWindow->setCurrentIndex(visualizationPageIndex);
                                               } else if (currentDataStructure == "Graph") {
                                                   currentGraphVisualization = new GraphVisualization();
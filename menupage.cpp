@@ -61,7 +61,7 @@ void MenuPage::setupUI()
     containerLayout->addWidget(subtitleLabel);
     containerLayout->addSpacing(50);
 
-    // Create grid layout for cards (2x2)
+    // Create grid layout for cards (2x2, radix tree centred below)
     QGridLayout *gridLayout = new QGridLayout();
     gridLayout->setSpacing(34);
     gridLayout->setContentsMargins(0, 0, 0, 0);
@@ -95,17 +95,26 @@ void MenuPage::setupUI()
         hashTableButton
         );
 
+    QWidget *radixCard = createMenuCard(
+        "Radix Tree",
+        "Ordered string keys with prefix search",
+        "🔤",
+        radixTreeButton
+        );
+
     // Add cards to grid (2 columns)
     gridLayout->addWidget(treeCard, 0, 0);
     gridLayout->addWidget(rbTreeCard, 0, 1);
     gridLayout->addWidget(graphCard, 1, 0);
     gridLayout->addWidget(hashCard, 1, 1);
+    gridLayout->addWidget(radixCard, 2, 0, 1, 2, Qt::AlignHCenter);
 
     // Store cards for animation
     cards.append(treeCard);
     cards.append(rbTreeCard);
     cards.append(graphCard);
     cards.append(hashCard);
+    cards.append(radixCard);
 
     containerLayout->addLayout(gridLayout);
     containerLayout->addStretch();
@@ -118,6 +127,7 @@ void MenuPage::setupUI()
     connect(rbTreeButton, &QPushButton::clicked, this, &MenuPage::onRedBlackTreeClicked);
     connect(graphButton, &QPushButton::clicked, this, &MenuPage::onGraphClicked);
     connect(hashTableButton, &QPushButton::clicked, this, &MenuPage::onHashTableClicked);
+    connect(radixTreeButton, &QPushButton::clicked, this, &MenuPage::onRadixTreeClicked);
 
     setLayout(mainLayout);
 }
@@ -341,3 +351,9 @@ void MenuPage::onHashTableClicked()
     qDebug() << "Hash Table visualization opened";
     emit dataStructureSelected("Hash Table");
 }
+
+void MenuPage::onRadixTreeClicked()
+{
+    qDebug() << "Radix Tree visualization opened";
+    emit dataStructureSelected("Radix Tree");
+}
@@ -45,6 +45,7 @@ private slots:
     void onRedBlackTreeClicked();
     void onGraphClicked();
     void onHashTableClicked();
+    void onRadixTreeClicked();
 
 private:
     void setupUI();
@@ -60,6 +61,7 @@ private:
     QPushButton *rbTreeButton;
     QPushButton *graphButton;
     QPushButton *hashTableButton;
+    QPushButton *radixTreeButton;
 
     QWidget *menuContainer;
     QVector<QWidget*> cards;
@@ -0,0 +1,983 @@
+#pragma once
+
+#include "hashmapcore.h"
+#include "radixtreetrace.h"
+#include <QByteArray>
+#include <QStringView>
+#include <QVector>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RADIXTREE_HAVE_SSE2 1
+#endif
+
+// A string key as the bytes the tree branches on: every UTF-16 code unit
+// as two big-endian bytes. Byte order is then QString's code-unit order, so
+// an in-order walk is sorted like QString::compare, and a string prefix is
+// a byte prefix. Nothing is copied; bytes are read from the view.
+struct RadixKey {
+    QStringView text;
+
+    int length() const { return 2 * static_cast<int>(text.size()); }
+
+    quint8 operator[](int i) const {
+        const char16_t unit = text[i >> 1].unicode();
+        return static_cast<quint8>((i & 1) ? unit & 0xFF : unit >> 8);
+    }
+};
+
+enum class RadixNodeKind : quint8 {
+    Leaf,
+    Node4,
+    Node16,
+    Node48,
+    Node256
+};
+
+// Node16 key search: the up to 16 sorted edge bytes are compared in one
+// SSE2 instruction instead of a loop or binary search
+struct RadixNode16Keys {
+    // Index of byte among the first count keys, or -1
+    static int find(const quint8 *keys, int count, quint8 byte) {
+#ifdef RADIXTREE_HAVE_SSE2
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys));
+        const __m128i equal = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)), group);
+        const quint32 mask = static_cast<quint32>(_mm_movemask_epi8(equal)) & ((1u << count) - 1);
+        return mask ? static_cast<int>(qCountTrailingZeroBits(mask)) : -1;
+#else
+        for (int i = 0; i < count; ++i) {
+            if (keys[i] == byte) return i;
+        }
+        return -1;
+#endif
+    }
+
+    // Index of the first key >= byte (count if none)
+    static int lowerBound(const quint8 *keys, int count, quint8 byte) {
+#ifdef RADIXTREE_HAVE_SSE2
+        // SSE2 compares signed bytes; flipping the sign bit orders them unsigned
+        const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+        const __m128i group = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys)), bias);
+        const __m128i probe = _mm_xor_si128(_mm_set1_epi8(static_cast<char>(byte)), bias);
+        const quint32 less = static_cast<quint32>(_mm_movemask_epi8(_mm_cmplt_epi8(group, probe))) & ((1u << count) - 1);
+        return static_cast<int>(qPopulationCount(less));
+#else
+        int i = 0;
+        while (i < count && keys[i] < byte) ++i;
+        return i;
+#endif
+    }
+};
+
+// Adaptive radix tree (Leis et al.) over string keys. Inner nodes come in
+// four sizes (Node4, Node16, Node48, Node256) and grow or shrink with their
+// fan-out; runs of single-child nodes are collapsed into a compressed path
+// stored on the node below (pessimistic path compression), and a key that
+// becomes unique hangs as a leaf directly under the last shared node. A key
+// that ends at an inner node (a prefix of other keys) is held there as its
+// terminal leaf.
+//
+// Lookups cost O(key length), independent of the number of keys, and the
+// structure is ordered: in-order, prefix and range scans visit keys sorted
+// without collecting and sorting them. Tracer works as for the hash map
+// backends; the caller records the Begin* step and separator around each
+// operation.
+template <typename V, typename Tracer = StepTrace>
+class AdaptiveRadixTree {
+public:
+    using ValueType = V;
+
+    explicit AdaptiveRadixTree(StepLog *steps = nullptr) : tracer_(steps) {}
+    ~AdaptiveRadixTree() { destroy(root_); }
+
+    AdaptiveRadixTree(const AdaptiveRadixTree &) = delete;
+    AdaptiveRadixTree &operator=(const AdaptiveRadixTree &) = delete;
+
+    // Insert without overwriting; returns true if a new key was added
+    bool insert(const QString &key, const V &value) {
+        return insertAt(&root_, key, RadixKey{key}, 0, value, /*assignIfExists=*/false);
+    }
+
+    // Insert or overwrite; returns true if a new key was added
+    bool put(const QString &key, const V &value) {
+        return insertAt(&root_, key, RadixKey{key}, 0, value, /*assignIfExists=*/true);
+    }
+
+    // Returns a pointer to the stored value, or nullptr if absent
+    const V *find(QStringView key) {
+        const RadixKey bytes{key};
+        Node *node = root_;
+        int depth = 0;
+        while (node) {
+            if (node->kind == RadixNodeKind::Leaf) {
+                Leaf *leaf = static_cast<Leaf *>(node);
+                const bool match = leaf->key == key;
+                addKeyStep(RadixTreeTrace::ReachLeaf, leaf->key, match ? RadixTreeTrace::Match : 0);
+                if (!match) break;
+                addValueStep(RadixTreeTrace::Found, leaf->value);
+                return &leaf->value;
+            }
+            Inner *inner = static_cast<Inner *>(node);
+            addStep(RadixTreeTrace::EnterNode, static_cast<int>(inner->kind), inner->count, 0, static_cast<quint64>(depth));
+            if (!matchPath(inner, bytes, depth)) break;
+            if (depth == bytes.length()) {
+                addStep(RadixTreeTrace::KeyEndsHere, -1, 0, inner->terminal ? RadixTreeTrace::Match : 0);
+                if (!inner->terminal) break;
+                addValueStep(RadixTreeTrace::Found, inner->terminal->value);
+                return &inner->terminal->value;
+            }
+            Node *const *child = findChild(inner, bytes[depth]);
+            if (!child) {
+                addStep(RadixTreeTrace::NoEdge, bytes[depth]);
+                break;
+            }
+            addStep(RadixTreeTrace::FollowEdge, bytes[depth], 0,
+                    inner->kind == RadixNodeKind::Node16 ? RadixTreeTrace::Simd : 0);
+            node = *child;
+            ++depth;
+        }
+        addStep(RadixTreeTrace::NotFound);
+        return nullptr;
+    }
+
+    bool erase(QStringView key) {
+        const bool removed = eraseAt(&root_, key, RadixKey{key}, 0);
+        if (removed) {
+            --size_;
+            addStep(RadixTreeTrace::Erased, -1, size_);
+        } else {
+            addStep(RadixTreeTrace::NotFound);
+        }
+        return removed;
+    }
+
+    void clear() {
+        destroy(root_);
+        root_ = nullptr;
+        size_ = 0;
+    }
+
+    int size() const { return size_; }
+    bool isEmpty() const { return size_ == 0; }
+
+    // Bulk inserts mute per-key steps; the caller records a summary
+    void muteSteps(bool muted) { tracer_.setMuted(muted); }
+
+    // Ordered scans. fn(const QString &key, const V &value) runs for each
+    // entry in key order; each stops after maxEntries (-1 visits all) and
+    // returns the number visited.
+    template <typename Fn>
+    int forEach(Fn &&fn, int maxEntries = -1) const {
+        Scan<Fn> scan{fn, maxEntries};
+        walk(root_, scan);
+        return scan.visited;
+    }
+
+    // Keys starting with prefix. Only the path down to the prefix and the
+    // subtree below it are touched.
+    template <typename Fn>
+    int forEachWithPrefix(QStringView prefix, Fn &&fn, int maxEntries = -1) {
+        Scan<Fn> scan{fn, maxEntries};
+        const RadixKey bytes{prefix};
+        Node *node = root_;
+        int depth = 0;
+        // Nodes passed on the way down are counted here, the subtree by walk()
+        while (node && depth < bytes.length()) {
+            if (node->kind == RadixNodeKind::Leaf) {
+                if (!static_cast<Leaf *>(node)->key.startsWith(prefix)) {
+                    ++scan.nodes;
+                    node = nullptr;
+                }
+                break;
+            }
+            ++scan.nodes;
+            Inner *inner = static_cast<Inner *>(node);
+            // The prefix may end inside the compressed path
+            const int compare = std::min(static_cast<int>(inner->path.size()), bytes.length() - depth);
+            int matched = 0;
+            while (matched < compare && inner->path[static_cast<size_t>(matched)] == bytes[depth + matched]) ++matched;
+            if (matched < compare) {
+                addStep(RadixTreeTrace::PathMismatch, -1, matched, RadixTreeTrace::Scan);
+                node = nullptr;
+                break;
+            }
+            depth += static_cast<int>(inner->path.size());
+            if (depth >= bytes.length()) {
+                --scan.nodes;
+                break;
+            }
+            Node *const *child = findChild(inner, bytes[depth]);
+            if (!child) {
+                addStep(RadixTreeTrace::NoEdge, bytes[depth], 0, RadixTreeTrace::Scan);
+                node = nullptr;
+                break;
+            }
+            addStep(RadixTreeTrace::FollowEdge, bytes[depth], 0,
+                    RadixTreeTrace::Scan | (inner->kind == RadixNodeKind::Node16 ? RadixTreeTrace::Simd : 0));
+            node = *child;
+            ++depth;
+        }
+        walk(node, scan);
+        addStep(RadixTreeTrace::ScanDone, scan.nodes, scan.visited);
+        return scan.visited;
+    }
+
+    // Keys in [from, to). Subtrees entirely outside the bounds are skipped
+    // by comparing compressed paths and edge bytes; Node16 finds its first
+    // edge >= the lower bound with one SSE2 compare.
+    template <typename Fn>
+    int forEachInRange(QStringView from, QStringView to, Fn &&fn, int maxEntries = -1) {
+        Scan<Fn> scan{fn, maxEntries};
+        RangeBounds bounds{RadixKey{from}, RadixKey{to}};
+        walkRange(root_, 0, true, true, bounds, scan);
+        addStep(RadixTreeTrace::ScanDone, scan.nodes, scan.visited);
+        return scan.visited;
+    }
+
+    // Node counts and shape, for the stats row
+    struct Stats {
+        int node4 = 0;
+        int node16 = 0;
+        int node48 = 0;
+        int node256 = 0;
+        int leaves = 0;
+        int height = 0;     // nodes on the longest root-to-leaf path
+        int pathBytes = 0;  // bytes held in compressed paths
+    };
+
+    Stats stats() const {
+        Stats s;
+        collectStats(root_, 1, s);
+        return s;
+    }
+
+    // Flattened tree for drawing, parents before children, at most
+    // maxNodes entries (breadth-first, so the top levels are kept)
+    struct NodeView {
+        RadixNodeKind kind = RadixNodeKind::Leaf;
+        int parent = -1;   // index of the parent view, -1 for the root
+        int edge = -1;     // byte on the edge from the parent, -1 for a terminal leaf
+        int level = 0;
+        QByteArray path;   // compressed path of an inner node
+        QString key;       // leaf key
+        V value{};
+        int children = 0;  // edges of an inner node, terminal not counted
+    };
+
+    QVector<NodeView> nodeViews(int maxNodes) const {
+        QVector<NodeView> views;
+        if (!root_ || maxNodes <= 0) return views;
+        views.push_back(viewOf(root_, -1, -1, 0));
+        std::vector<const Node *> nodes{root_};
+        for (int i = 0; i < views.size() && views.size() < maxNodes; ++i) {
+            if (nodes[static_cast<size_t>(i)]->kind == RadixNodeKind::Leaf) continue;
+            const Inner *inner = static_cast<const Inner *>(nodes[static_cast<size_t>(i)]);
+            const int level = views[i].level + 1;
+            if (inner->terminal && views.size() < maxNodes) {
+                views.push_back(viewOf(inner->terminal, i, -1, level));
+                nodes.push_back(inner->terminal);
+            }
+            forEachChild(inner, 0, [&](quint8 byte, const Node *child) {
+                if (views.size() >= maxNodes) return false;
+                views.push_back(viewOf(child, i, byte, level));
+                nodes.push_back(child);
+                return true;
+            });
+        }
+        return views;
+    }
+
+private:
+    struct Node {
+        RadixNodeKind kind;
+        explicit Node(RadixNodeKind k) : kind(k) {}
+    };
+
+    struct Leaf : Node {
+        QString key;
+        V value;
+        Leaf(const QString &k, const V &v) : Node(RadixNodeKind::Leaf), key(k), value(v) {}
+    };
+
+    struct Inner : Node {
+        std::vector<quint8> path;  // compressed bytes matched before branching
+        Leaf *terminal = nullptr;  // key ending exactly at this node
+        int count = 0;             // edges in use
+        explicit Inner(RadixNodeKind k) : Node(k) {}
+    };
+
+    // Node4 and Node16 keep their edge bytes sorted with children in step
+    struct Node4 : Inner {
+        quint8 keys[4] = {};
+        Node *children[4] = {};
+        Node4() : Inner(RadixNodeKind::Node4) {}
+    };
+
+    struct Node16 : Inner {
+        alignas(16) quint8 keys[16] = {};
+        Node *children[16] = {};
+        Node16() : Inner(RadixNodeKind::Node16) {}
+    };
+
+    // index[byte] is 1 + the child slot, 0 for no edge
+    struct Node48 : Inner {
+        quint8 index[256] = {};
+        Node *children[48] = {};
+        Node48() : Inner(RadixNodeKind::Node48) {}
+    };
+
+    struct Node256 : Inner {
+        Node *children[256] = {};
+        Node256() : Inner(RadixNodeKind::Node256) {}
+    };
+
+    // Shrink thresholds sit below the grow points so a node that just
+    // grew does not shrink straight back
+    static constexpr int Node16ShrinkAt = 3;
+    static constexpr int Node48ShrinkAt = 12;
+    static constexpr int Node256ShrinkAt = 37;
+
+    Node *root_ = nullptr;
+    int size_ = 0;
+    Tracer tracer_;
+
+    template <typename Fn>
+    struct Scan {
+        Fn &fn;
+        int maxEntries;
+        int visited = 0;
+        int nodes = 0;
+
+        bool full() const { return maxEntries >= 0 && visited >= maxEntries; }
+        bool emit(const Leaf *leaf) {
+            if (full()) return false;
+            fn(leaf->key, leaf->value);
+            ++visited;
+            return !full();
+        }
+    };
+
+    struct RangeBounds {
+        RadixKey from;
+        RadixKey to;
+        QStringView fromText() const { return from.text; }
+        QStringView toText() const { return to.text; }
+    };
+
+    // Tracing
+
+    void addStep(RadixTreeTrace::Op op, int bucket = -1, int result = 0, quint16 flags = 0, quint64 hash = 0) {
+        if constexpr (Tracer::enabled) {
+            StepEvent event;
+            event.op = op;
+            event.flags = flags;
+            event.bucket = bucket;
+            event.result = result;
+            event.hash = hash;
+            tracer_.record(event);
+        }
+    }
+
+    void addKeyStep(RadixTreeTrace::Op op, const QString &key, quint16 flags = 0, int bucket = -1) {
+        if constexpr (Tracer::enabled) {
+            if (!tracer_.active()) return;
+            StepEvent event;
+            event.op = op;
+            event.flags = flags;
+            event.bucket = bucket;
+            event.key = tracer_.operand(QVariant(key));
+            tracer_.record(event);
+        }
+    }
+
+    void addValueStep(RadixTreeTrace::Op op, const V &value, const V *newValue = nullptr) {
+        if constexpr (Tracer::enabled) {
+            if (!tracer_.active()) return;
+            StepEvent event;
+            event.op = op;
+            event.key = tracer_.operand(QVariant::fromValue(value));
+            if (newValue) event.result = tracer_.operand(QVariant::fromValue(*newValue));
+            tracer_.record(event);
+        }
+    }
+
+    // Node helpers
+
+    static Leaf *asLeaf(Node *node) { return static_cast<Leaf *>(node); }
+
+    static void destroy(Node *node) {
+        if (!node) return;
+        if (node->kind == RadixNodeKind::Leaf) {
+            delete static_cast<Leaf *>(node);
+            return;
+        }
+        Inner *inner = static_cast<Inner *>(node);
+        delete inner->terminal;
+        forEachChild(inner, 0, [](quint8, Node *child) {
+            destroy(child);
+            return true;
+        });
+        deleteInner(inner);
+    }
+
+    static void deleteInner(Inner *inner) {
+        switch (inner->kind) {
+        case RadixNodeKind::Node4: delete static_cast<Node4 *>(inner); break;
+        case RadixNodeKind::Node16: delete static_cast<Node16 *>(inner); break;
+        case RadixNodeKind::Node48: delete static_cast<Node48 *>(inner); break;
+        case RadixNodeKind::Node256: delete static_cast<Node256 *>(inner); break;
+        case RadixNodeKind::Leaf: break;
+        }
+    }
+
+    // Address of the child slot for byte, or nullptr
+    static Node *const *findChild(const Inner *inner, quint8 byte) {
+        switch (inner->kind) {
+        case RadixNodeKind::Node4: {
+            const Node4 *n = static_cast<const Node4 *>(inner);
+            for (int i = 0; i < n->count; ++i) {
+                if (n->keys[i] == byte) return &n->children[i];
+            }
+            return nullptr;
+        }
+        case RadixNodeKind::Node16: {
+            const Node16 *n = static_cast<const Node16 *>(inner);
+            const int i = RadixNode16Keys::find(n->keys, n->count, byte);
+            return i < 0 ? nullptr : &n->children[i];
+        }
+        case RadixNodeKind::Node48: {
+            const Node48 *n = static_cast<const Node48 *>(inner);
+            return n->index[byte] ? &n->children[n->index[byte] - 1] : nullptr;
+        }
+        case RadixNodeKind::Node256: {
+            const Node256 *n = static_cast<const Node256 *>(inner);
+            return n->children[byte] ? &n->children[byte] : nullptr;
+        }
+        case RadixNodeKind::Leaf:
+            break;
+        }
+        return nullptr;
+    }
+
+    static Node **findChild(Inner *inner, quint8 byte) {
+        return const_cast<Node **>(findChild(static_cast<const Inner *>(inner), byte));
+    }
+
+    // Calls fn(byte, child) in byte order for edges >= firstByte until it
+    // returns false; returns false if stopped
+    template <typename NodePtr, typename Fn>
+    static bool forEachChild(NodePtr inner, int firstByte, Fn &&fn) {
+        switch (inner->kind) {
+        case RadixNodeKind::Node4: {
+            auto *n = static_cast<const Node4 *>(inner);
+            for (int i = 0; i < n->count; ++i) {
+                if (n->keys[i] >= firstByte && !fn(n->keys[i], n->children[i])) return false;
+            }
+            break;
+        }
+        case RadixNodeKind::Node16: {
+            auto *n = static_cast<const Node16 *>(inner);
+            const int first = firstByte > 0 ? RadixNode16Keys::lowerBound(n->keys, n->count, static_cast<quint8>(firstByte)) : 0;
+            for (int i = first; i < n->count; ++i) {
+                if (!fn(n->keys[i], n->children[i])) return false;
+            }
+            break;
+        }
+        case RadixNodeKind::Node48: {
+            auto *n = static_cast<const Node48 *>(inner);
+            for (int b = firstByte; b < 256; ++b) {
+                if (n->index[b] && !fn(static_cast<quint8>(b), n->children[n->index[b] - 1])) return false;
+            }
+            break;
+        }
+        case RadixNodeKind::Node256: {
+            auto *n = static_cast<const Node256 *>(inner);
+            for (int b = firstByte; b < 256; ++b) {
+                if (n->children[b] && !fn(static_cast<quint8>(b), n->children[b])) return false;
+            }
+            break;
+        }
+        case RadixNodeKind::Leaf:
+            break;
+        }
+        return true;
+    }
+
+    // Moves the common header (path, terminal, count) to a resized node
+    static void moveHeader(Inner *from, Inner *to) {
+        to->path = std::move(from->path);
+        to->terminal = from->terminal;
+        to->count = from->count;
+        from->terminal = nullptr;
+    }
+
+    // Adds an edge to the node at *ref, growing it first when full
+    void addChild(Node **ref, quint8 byte, Node *child) {
+        Inner *inner = static_cast<Inner *>(*ref);
+        switch (inner->kind) {
+        case RadixNodeKind::Node4: {
+            Node4 *n = static_cast<Node4 *>(inner);
+            if (n->count < 4) {
+                insertSorted(n->keys, n->children, n->count, byte, child);
+                return;
+            }
+            Node16 *grown = new Node16();
+            moveHeader(n, grown);
+            std::copy(n->keys, n->keys + 4, grown->keys);
+            std::copy(n->children, n->children + 4, grown->children);
+            addStep(RadixTreeTrace::GrowNode, static_cast<int>(RadixNodeKind::Node4), static_cast<int>(RadixNodeKind::Node16));
+            delete n;
+            *ref = grown;
+            addChild(ref, byte, child);
+            return;
+        }
+        case RadixNodeKind::Node16: {
+            Node16 *n = static_cast<Node16 *>(inner);
+            if (n->count < 16) {
+                insertSorted(n->keys, n->children, n->count, byte, child);
+                return;
+            }
+            Node48 *grown = new Node48();
+            moveHeader(n, grown);
+            for (int i = 0; i < 16; ++i) {
+                grown->children[i] = n->children[i];
+                grown->index[n->keys[i]] = static_cast<quint8>(i + 1);
+            }
+            addStep(RadixTreeTrace::GrowNode, static_cast<int>(RadixNodeKind::Node16), static_cast<int>(RadixNodeKind::Node48));
+            delete n;
+            *ref = grown;
+            addChild(ref, byte, child);
+            return;
+        }
+        case RadixNodeKind::Node48: {
+            Node48 *n = static_cast<Node48 *>(inner);
+            if (n->count < 48) {
+                int slot = 0;
+                while (n->children[slot]) ++slot;
+                n->children[slot] = child;
+                n->index[byte] = static_cast<quint8>(slot + 1);
+                ++n->count;
+                return;
+            }
+            Node256 *grown = new Node256();
+            moveHeader(n, grown);
+            for (int b = 0; b < 256; ++b) {
+                if (n->index[b]) grown->children[b] = n->children[n->index[b] - 1];
+            }
+            addStep(RadixTreeTrace::GrowNode, static_cast<int>(RadixNodeKind::Node48), static_cast<int>(RadixNodeKind::Node256));
+            delete n;
+            *ref = grown;
+            addChild(ref, byte, child);
+            return;
+        }
+        case RadixNodeKind::Node256: {
+            Node256 *n = static_cast<Node256 *>(inner);
+            n->children[byte] = child;
+            ++n->count;
+            return;
+        }
+        case RadixNodeKind::Leaf:
+            break;
+        }
+    }
+
+    static void insertSorted(quint8 *keys, Node **children, int &count, quint8 byte, Node *child) {
+        int pos = 0;
+        while (pos < count && keys[pos] < byte) ++pos;
+        std::copy_backward(keys + pos, keys + count, keys + count + 1);
+        std::copy_backward(children + pos, children + count, children + count + 1);
+        keys[pos] = byte;
+        children[pos] = child;
+        ++count;
+    }
+
+    static void removeSorted(quint8 *keys, Node **children, int &count, quint8 byte) {
+        int pos = 0;
+        while (keys[pos] != byte) ++pos;
+        std::copy(keys + pos + 1, keys + count, keys + pos);
+        std::copy(children + pos + 1, children + count, children + pos);
+        --count;
+        keys[count] = 0;
+        children[count] = nullptr;
+    }
+
+    // Removes an edge from the node at *ref, then shrinks or collapses it
+    void removeChild(Node **ref, quint8 byte) {
+        Inner *inner = static_cast<Inner *>(*ref);
+        switch (inner->kind) {
+        case RadixNodeKind::Node4: {
+            Node4 *n = static_cast<Node4 *>(inner);
+            removeSorted(n->keys, n->children, n->count, byte);
+            break;
+        }
+        case RadixNodeKind::Node16: {
+            Node16 *n = static_cast<Node16 *>(inner);
+            removeSorted(n->keys, n->children, n->count, byte);
+            if (n->count <= Node16ShrinkAt) {
+                Node4 *shrunk = new Node4();
+                moveHeader(n, shrunk);
+                std::copy(n->keys, n->keys + n->count, shrunk->keys);
+                std::copy(n->children, n->children + n->count, shrunk->children);
+                addStep(RadixTreeTrace::ShrinkNode, static_cast<int>(RadixNodeKind::Node16), static_cast<int>(RadixNodeKind::Node4));
+                delete n;
+                *ref = shrunk;
+            }
+            break;
+        }
+        case RadixNodeKind::Node48: {
+            Node48 *n = static_cast<Node48 *>(inner);
+            n->children[n->index[byte] - 1] = nullptr;
+            n->index[byte] = 0;
+            --n->count;
+            if (n->count <= Node48ShrinkAt) {
+                Node16 *shrunk = new Node16();
+                moveHeader(n, shrunk);
+                int i = 0;
+                for (int b = 0; b < 256; ++b) {
+                    if (!n->index[b]) continue;
+                    shrunk->keys[i] = static_cast<quint8>(b);
+                    shrunk->children[i] = n->children[n->index[b] - 1];
+                    ++i;
+                }
+                addStep(RadixTreeTrace::ShrinkNode, static_cast<int>(RadixNodeKind::Node48), static_cast<int>(RadixNodeKind::Node16));
+                delete n;
+                *ref = shrunk;
+            }
+            break;
+        }
+        case RadixNodeKind::Node256: {
+            Node256 *n = static_cast<Node256 *>(inner);
+            n->children[byte] = nullptr;
+            --n->count;
+            if (n->count <= Node256ShrinkAt) {
+                Node48 *shrunk = new Node48();
+                moveHeader(n, shrunk);
+                int slot = 0;
+                for (int b = 0; b < 256; ++b) {
+                    if (!n->children[b]) continue;
+                    shrunk->children[slot] = n->children[b];
+                    shrunk->index[b] = static_cast<quint8>(slot + 1);
+                    ++slot;
+                }
+                addStep(RadixTreeTrace::ShrinkNode, static_cast<int>(RadixNodeKind::Node256), static_cast<int>(RadixNodeKind::Node48));
+                delete n;
+                *ref = shrunk;
+            }
+            break;
+        }
+        case RadixNodeKind::Leaf:
+            break;
+        }
+        collapse(ref);
+    }
+
+    // A node left with a single entry is removed from the path: a lone leaf
+    // (edge or terminal) takes its place, and a lone inner child absorbs the
+    // node's path and edge byte into its own
+    void collapse(Node **ref) {
+        Inner *inner = static_cast<Inner *>(*ref);
+        if (inner->count + (inner->terminal ? 1 : 0) > 1) return;
+
+        if (inner->count == 0) {
+            *ref = inner->terminal;
+            inner->terminal = nullptr;
+            addStep(RadixTreeTrace::CollapseToLeaf);
+            deleteInner(inner);
+            return;
+        }
+
+        quint8 byte = 0;
+        Node *child = nullptr;
+        forEachChild(inner, 0, [&](quint8 b, Node *c) {
+            byte = b;
+            child = c;
+            return false;
+        });
+        if (child->kind == RadixNodeKind::Leaf) {
+            addStep(RadixTreeTrace::CollapseToLeaf);
+        } else {
+            Inner *below = static_cast<Inner *>(child);
+            std::vector<quint8> merged = std::move(inner->path);
+            merged.push_back(byte);
+            merged.insert(merged.end(), below->path.begin(), below->path.end());
+            below->path = std::move(merged);
+            addStep(RadixTreeTrace::MergePath, -1, static_cast<int>(below->path.size()));
+        }
+        *ref = child;
+        deleteInner(inner);
+    }
+
+    // Compares the compressed path against the key from depth; on a match
+    // advances depth past it
+    bool matchPath(const Inner *inner, const RadixKey &bytes, int &depth) {
+        const int length = static_cast<int>(inner->path.size());
+        if (length == 0) return true;
+        int matched = 0;
+        while (matched < length && depth + matched < bytes.length()
+               && inner->path[static_cast<size_t>(matched)] == bytes[depth + matched]) {
+            ++matched;
+        }
+        if (matched < length) {
+            addStep(RadixTreeTrace::PathMismatch, -1, matched);
+            return false;
+        }
+        depth += length;
+        addStep(RadixTreeTrace::PathMatch, -1, length, 0, static_cast<quint64>(depth));
+        return true;
+    }
+
+    Leaf *newLeaf(const QString &key, const V &value, int edge) {
+        addKeyStep(RadixTreeTrace::AddLeaf, key, 0, edge);
+        ++size_;
+        return new Leaf(key, value);
+    }
+
+    // Puts leaf under a node: as its terminal when the key ends at depth,
+    // otherwise on the edge for the key's next byte
+    void attach(Node **ref, Leaf *leaf, const RadixKey &bytes, int depth) {
+        if (depth == bytes.length()) {
+            static_cast<Inner *>(*ref)->terminal = leaf;
+        } else {
+            addChild(ref, bytes[depth], leaf);
+        }
+    }
+
+    bool assignExisting(Leaf *leaf, const V &value, bool assignIfExists) {
+        if (assignIfExists) {
+            addValueStep(RadixTreeTrace::UpdateValue, leaf->value, &value);
+            leaf->value = value;
+        } else {
+            addStep(RadixTreeTrace::Duplicate);
+        }
+        return false; // not a new insertion
+    }
+
+    bool insertAt(Node **ref, const QString &key, const RadixKey &bytes, int depth, const V &value, bool assignIfExists) {
+        Node *node = *ref;
+        if (!node) {
+            *ref = newLeaf(key, value, -1);
+            return true;
+        }
+
+        if (node->kind == RadixNodeKind::Leaf) {
+            Leaf *leaf = asLeaf(node);
+            const bool match = leaf->key == key;
+            addKeyStep(RadixTreeTrace::ReachLeaf, leaf->key, match ? RadixTreeTrace::Match : 0);
+            if (match) return assignExisting(leaf, value, assignIfExists);
+
+            // Lazy expansion ends here: both keys go under a new Node4 whose
+            // path holds the bytes they still share
+            const RadixKey other{leaf->key};
+            int shared = 0;
+            while (depth + shared < bytes.length() && depth + shared < other.length()
+                   && bytes[depth + shared] == other[depth + shared]) {
+                ++shared;
+            }
+            Node4 *split = new Node4();
+            for (int i = 0; i < shared; ++i) split->path.push_back(bytes[depth + i]);
+            addStep(RadixTreeTrace::SplitLeaf, -1, shared);
+            *ref = split;
+            attach(ref, leaf, other, depth + shared);
+            const int edge = depth + shared < bytes.length() ? bytes[depth + shared] : -1;
+            attach(ref, newLeaf(key, value, edge), bytes, depth + shared);
+            return true;
+        }
+
+        Inner *inner = static_cast<Inner *>(node);
+        addStep(RadixTreeTrace::EnterNode, static_cast<int>(inner->kind), inner->count, 0, static_cast<quint64>(depth));
+
+        const int length = static_cast<int>(inner->path.size());
+        int matched = 0;
+        while (matched < length && depth + matched < bytes.length()
+               && inner->path[static_cast<size_t>(matched)] == bytes[depth + matched]) {
+            ++matched;
+        }
+        if (matched < length) {
+            // The key leaves the compressed path: split it with a Node4 that
+            // keeps the shared part, the old node hanging off its next byte
+            addStep(RadixTreeTrace::PathMismatch, -1, matched);
+            Node4 *split = new Node4();
+            split->path.assign(inner->path.begin(), inner->path.begin() + matched);
+            const quint8 oldByte = inner->path[static_cast<size_t>(matched)];
+            inner->path.erase(inner->path.begin(), inner->path.begin() + matched + 1);
+            addStep(RadixTreeTrace::SplitPath, oldByte, matched);
+            *ref = split;
+            addChild(ref, oldByte, inner);
+            const int edge = depth + matched < bytes.length() ? bytes[depth + matched] : -1;
+            attach(ref, newLeaf(key, value, edge), bytes, depth + matched);
+            return true;
+        }
+        depth += length;
+        if (length > 0) addStep(RadixTreeTrace::PathMatch, -1, length, 0, static_cast<quint64>(depth));
+
+        if (depth == bytes.length()) {
+            addStep(RadixTreeTrace::KeyEndsHere, -1, 0, inner->terminal ? RadixTreeTrace::Match : 0);
+            if (inner->terminal) return assignExisting(inner->terminal, value, assignIfExists);
+            inner->terminal = newLeaf(key, value, -1);
+            return true;
+        }
+
+        Node **child = findChild(inner, bytes[depth]);
+        if (child) {
+            addStep(RadixTreeTrace::FollowEdge, bytes[depth], 0,
+                    inner->kind == RadixNodeKind::Node16 ? RadixTreeTrace::Simd : 0);
+            return insertAt(child, key, bytes, depth + 1, value, assignIfExists);
+        }
+        addStep(RadixTreeTrace::NoEdge, bytes[depth]);
+        addChild(ref, bytes[depth], newLeaf(key, value, bytes[depth]));
+        return true;
+    }
+
+    bool eraseAt(Node **ref, QStringView key, const RadixKey &bytes, int depth) {
+        Node *node = *ref;
+        if (!node) return false;
+
+        if (node->kind == RadixNodeKind::Leaf) {
+            // Only reached for a leaf at the root
+            const bool match = asLeaf(node)->key == key;
+            addKeyStep(RadixTreeTrace::ReachLeaf, asLeaf(node)->key, match ? RadixTreeTrace::Match : 0);
+            if (!match) return false;
+            delete asLeaf(node);
+            *ref = nullptr;
+            return true;
+        }
+
+        Inner *inner = static_cast<Inner *>(node);
+        addStep(RadixTreeTrace::EnterNode, static_cast<int>(inner->kind), inner->count, 0, static_cast<quint64>(depth));
+        if (!matchPath(inner, bytes, depth)) return false;
+
+        if (depth == bytes.length()) {
+            addStep(RadixTreeTrace::KeyEndsHere, -1, 0, inner->terminal ? RadixTreeTrace::Match : 0);
+            if (!inner->terminal) return false;
+            delete inner->terminal;
+            inner->terminal = nullptr;
+            collapse(ref);
+            return true;
+        }
+
+        Node **child = findChild(inner, bytes[depth]);
+        if (!child) {
+            addStep(RadixTreeTrace::NoEdge, bytes[depth]);
+            return false;
+        }
+        addStep(RadixTreeTrace::FollowEdge, bytes[depth], 0,
+                inner->kind == RadixNodeKind::Node16 ? RadixTreeTrace::Simd : 0);
+
+        if ((*child)->kind == RadixNodeKind::Leaf) {
+            Leaf *leaf = asLeaf(*child);
+            const bool match = leaf->key == key;
+            addKeyStep(RadixTreeTrace::ReachLeaf, leaf->key, match ? RadixTreeTrace::Match : 0);
+            if (!match) return false;
+            delete leaf;
+            removeChild(ref, bytes[depth]);
+            return true;
+        }
+        return eraseAt(child, key, bytes, depth + 1);
+    }
+
+    // In-order walk: a node's terminal key is a prefix of every key below
+    // it, so it comes first, then the edges in byte order
+    template <typename Fn>
+    bool walk(const Node *node, Scan<Fn> &scan) const {
+        if (!node) return true;
+        ++scan.nodes;
+        if (node->kind == RadixNodeKind::Leaf) return scan.emit(static_cast<const Leaf *>(node));
+        const Inner *inner = static_cast<const Inner *>(node);
+        if (inner->terminal && !scan.emit(inner->terminal)) return false;
+        return forEachChild(inner, 0, [&](quint8, const Node *child) { return walk(child, scan); });
+    }
+
+    // Range walk. checkLow/checkHigh say whether keys in this subtree can
+    // still fall below from / at or above to; once a path byte settles a
+    // bound the check is dropped for the whole subtree.
+    template <typename Fn>
+    bool walkRange(const Node *node, int depth, bool checkLow, bool checkHigh,
+                   const RangeBounds &bounds, Scan<Fn> &scan) {
+        if (!node) return true;
+        ++scan.nodes;
+        if (node->kind == RadixNodeKind::Leaf) {
+            const Leaf *leaf = static_cast<const Leaf *>(node);
+            if (checkLow && QStringView(leaf->key) < bounds.fromText()) return true;
+            if (checkHigh && !(QStringView(leaf->key) < bounds.toText())) return true;
+            return scan.emit(leaf);
+        }
+
+        const Inner *inner = static_cast<const Inner *>(node);
+        for (size_t i = 0; i < inner->path.size() && (checkLow || checkHigh); ++i) {
+            const int at = depth + static_cast<int>(i);
+            const quint8 byte = inner->path[i];
+            if (checkLow) {
+                // from ending inside the path is a proper prefix of every key here
+                if (at >= bounds.from.length() || byte > bounds.from[at]) {
+                    checkLow = false;
+                } else if (byte < bounds.from[at]) {
+                    return true;
+                }
+            }
+            if (checkHigh) {
+                if (at >= bounds.to.length() || byte > bounds.to[at]) return true;
+                if (byte < bounds.to[at]) checkHigh = false;
+            }
+        }
+        depth += static_cast<int>(inner->path.size());
+
+        if (inner->terminal) {
+            // The terminal key is exactly the bytes so far
+            const bool aboveLow = !checkLow || depth >= bounds.from.length();
+            const bool belowHigh = !checkHigh || depth < bounds.to.length();
+            if (aboveLow && belowHigh && !scan.emit(inner->terminal)) return false;
+        }
+        // Every key below has more than depth bytes, so a bound that ends
+        // here is below all of them
+        if (checkLow && depth >= bounds.from.length()) checkLow = false;
+        if (checkHigh && depth >= bounds.to.length()) return true;
+
+        // Stops at the first edge past to, or once the scan is full
+        const int first = checkLow ? bounds.from[depth] : 0;
+        forEachChild(inner, first, [&](quint8 byte, const Node *child) {
+            if (checkHigh && byte > bounds.to[depth]) return false;
+            return walkRange(child, depth + 1, checkLow && byte == bounds.from[depth],
+                             checkHigh && byte == bounds.to[depth], bounds, scan);
+        });
+        return !scan.full();
+    }
+
+    static void collectStats(const Node *node, int level, Stats &s) {
+        if (!node) return;
+        s.height = std::max(s.height, level);
+        switch (node->kind) {
+        case RadixNodeKind::Leaf: ++s.leaves; return;
+        case RadixNodeKind::Node4: ++s.node4; break;
+        case RadixNodeKind::Node16: ++s.node16; break;
+        case RadixNodeKind::Node48: ++s.node48; break;
+        case RadixNodeKind::Node256: ++s.node256; break;
+        }
+        const Inner *inner = static_cast<const Inner *>(node);
+        s.pathBytes += static_cast<int>(inner->path.size());
+        if (inner->terminal) collectStats(inner->terminal, level + 1, s);
+        forEachChild(inner, 0, [&](quint8, const Node *child) {
+            collectStats(child, level + 1, s);
+            return true;
+        });
+    }
+
+    static NodeView viewOf(const Node *node, int parent, int edge, int level) {
+        NodeView view;
+        view.kind = node->kind;
+        view.parent = parent;
+        view.edge = edge;
+        view.level = level;
+        if (node->kind == RadixNodeKind::Leaf) {
+            view.key = static_cast<const Leaf *>(node)->key;
+            view.value = static_cast<const Leaf *>(node)->value;
+        } else {
+            const Inner *inner = static_cast<const Inner *>(node);
+            view.path = QByteArray(reinterpret_cast<const char *>(inner->path.data()), static_cast<int>(inner->path.size()));
+            view.children = inner->count;
+        }
+        return view;
+    }
+};
@@ -0,0 +1,120 @@
+#include "radixtreetrace.h"
+#include "radixtree.h"
+
+namespace {
+
+QString operandText(const StepLog &log, qint32 handle) {
+    return handle < 0 ? QString() : log.operand(handle).toString();
+}
+
+} // namespace
+
+QString RadixTreeTrace::kindName(int kind) {
+    switch (static_cast<RadixNodeKind>(kind)) {
+    case RadixNodeKind::Leaf: return QStringLiteral("Leaf");
+    case RadixNodeKind::Node4: return QStringLiteral("Node4");
+    case RadixNodeKind::Node16: return QStringLiteral("Node16");
+    case RadixNodeKind::Node48: return QStringLiteral("Node48");
+    case RadixNodeKind::Node256: return QStringLiteral("Node256");
+    }
+    return QString();
+}
+
+// Keys are UTF-16 big-endian, so ASCII text shows up as a zero high byte
+// followed by the character; printable bytes are shown as characters
+QString RadixTreeTrace::byteText(int byte) {
+    if (byte >= 0x20 && byte < 0x7F) return QStringLiteral("'%1'").arg(QChar(byte));
+    return QStringLiteral("0x%1").arg(byte, 2, 16, QLatin1Char('0'));
+}
+
+// Zero high bytes are dropped so an ASCII path reads as its text
+QString RadixTreeTrace::pathText(const QByteArray &path) {
+    QString text;
+    for (const char c : path) {
+        const int byte = static_cast<quint8>(c);
+        if (byte == 0) continue;
+        if (byte >= 0x20 && byte < 0x7F) {
+            text += QChar(byte);
+        } else {
+            text += QStringLiteral("\\x%1").arg(byte, 2, 16, QLatin1Char('0'));
+        }
+    }
+    return text;
+}
+
+QString RadixTreeTrace::render(const StepEvent &e, const StepLog &log) {
+    switch (e.op) {
+    case BeginInsert: return QStringLiteral("➕ INSERT OPERATION");
+    case BeginPut: return QStringLiteral("➕ PUT OPERATION");
+    case BeginSearch: return QStringLiteral("🔍 SEARCH OPERATION");
+    case BeginDelete: return QStringLiteral("🗑️ DELETE OPERATION");
+    case BeginPrefixScan: return QStringLiteral("🔎 PREFIX SCAN: \"%1\"").arg(operandText(log, e.key));
+    case BeginRangeScan:
+        return QStringLiteral("📏 RANGE SCAN: [\"%1\", \"%2\")").arg(operandText(log, e.key), operandText(log, e.result));
+    case Cleared: return QStringLiteral("Cleared the tree");
+    case EnterNode:
+        return QStringLiteral("Enter %1 at depth %2 (%3 edge(s))").arg(kindName(e.bucket)).arg(e.hash).arg(e.result);
+    case PathMatch: return QStringLiteral("Compressed path of %1 byte(s) matches → depth %2").arg(e.result).arg(e.hash);
+    case PathMismatch: return QStringLiteral("Compressed path differs after %1 byte(s)").arg(e.result);
+    case FollowEdge:
+        return (e.flags & Simd) ? QStringLiteral("Follow edge %1 (Node16: all keys compared in one SIMD step)").arg(byteText(e.bucket))
+                                : QStringLiteral("Follow edge %1").arg(byteText(e.bucket));
+    case NoEdge: return QStringLiteral("No edge %1 → not here").arg(byteText(e.bucket));
+    case ReachLeaf:
+        return QStringLiteral("Reach leaf \"%1\": %2")
+            .arg(operandText(log, e.key), (e.flags & Match) ? QStringLiteral("key matches") : QStringLiteral("different key"));
+    case KeyEndsHere:
+        return (e.flags & Match) ? QStringLiteral("Key ends at this node → stored here")
+                                 : QStringLiteral("Key ends at this node → nothing stored here");
+    case Found: return QStringLiteral("Found → return value %1").arg(operandText(log, e.key));
+    case NotFound: return QStringLiteral("Key not found");
+    case UpdateValue:
+        return QStringLiteral("Key exists → update value: %1 → %2").arg(operandText(log, e.key), operandText(log, e.result));
+    case Duplicate: return QStringLiteral("Key exists → no insert (duplicate)");
+    case AddLeaf:
+        return e.bucket < 0 ? QStringLiteral("Store leaf \"%1\" at this node").arg(operandText(log, e.key))
+                            : QStringLiteral("Add leaf \"%1\" on edge %2").arg(operandText(log, e.key), byteText(e.bucket));
+    case SplitLeaf: return QStringLiteral("Two keys meet at a leaf → new Node4 with a %1-byte shared path").arg(e.result);
+    case SplitPath:
+        return QStringLiteral("Split compressed path: new Node4 keeps %1 byte(s), old node hangs on edge %2")
+            .arg(e.result)
+            .arg(byteText(e.bucket));
+    case GrowNode: return QStringLiteral("📈 Node full → grow %1 to %2").arg(kindName(e.bucket), kindName(e.result));
+    case ShrinkNode: return QStringLiteral("📉 Node underfull → shrink %1 to %2").arg(kindName(e.bucket), kindName(e.result));
+    case MergePath: return QStringLiteral("Single child left → merge into its path (%1 bytes)").arg(e.result);
+    case CollapseToLeaf: return QStringLiteral("Single leaf left → it replaces the node");
+    case Erased: return QStringLiteral("Erased. New size = %1").arg(e.result);
+    case ScanDone: return QStringLiteral("Scan returned %1 key(s) in order, touching %2 node(s)").arg(e.result).arg(e.bucket);
+    default:
+        return QString();
+    }
+}
+
+StepCategory RadixTreeTrace::category(const StepEvent &e, const StepLog &log) {
+    switch (e.op) {
+    case StepLog::TextOp: {
+        const QString text = log.operand(e.key).toString();
+        if (text.contains("✅")) return StepCategory::Success;
+        if (text.contains("❌")) return StepCategory::Failure;
+        if (text.contains("🔍") || text.contains("🔎") || text.contains("📏")) return StepCategory::Search;
+        if (text.contains("➕")) return StepCategory::Insert;
+        if (text.contains("🗑️")) return StepCategory::Delete;
+        if (text.contains("📈") || text.contains("📉")) return StepCategory::Calculate;
+        return StepCategory::Plain;
+    }
+    case BeginInsert:
+    case BeginPut:
+        return StepCategory::Insert;
+    case BeginSearch:
+    case BeginPrefixScan:
+    case BeginRangeScan:
+        return StepCategory::Search;
+    case BeginDelete:
+        return StepCategory::Delete;
+    case GrowNode:
+    case ShrinkNode:
+        return StepCategory::Calculate;
+    default:
+        return StepCategory::Plain;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "steplog.h"
+
+// Step opcodes emitted by AdaptiveRadixTree, and the renderer that turns
+// them into the radix tree page's sentences.
+struct RadixTreeTrace {
+    enum Op : quint16 {
+        BeginInsert = StepLog::FirstUserOp,
+        BeginPut,
+        BeginSearch,
+        BeginDelete,
+        BeginPrefixScan,  // key = prefix handle
+        BeginRangeScan,   // key = from handle, result = to handle
+        Cleared,
+        EnterNode,        // bucket = RadixNodeKind, result = children, hash = depth in bytes
+        PathMatch,        // result = compressed bytes matched, hash = depth after
+        PathMismatch,     // result = bytes matched before the mismatch
+        FollowEdge,       // bucket = edge byte
+        NoEdge,           // bucket = edge byte
+        ReachLeaf,        // key = leaf key handle
+        KeyEndsHere,      // lookup consumed every byte at an inner node
+        Found,            // key = value handle
+        NotFound,
+        UpdateValue,      // key = old value handle, result = new value handle
+        Duplicate,
+        AddLeaf,          // key = key handle, bucket = edge byte (-1: ends at the node)
+        SplitLeaf,        // result = shared bytes below the new Node4
+        SplitPath,        // result = bytes kept above the split, bucket = edge byte of the old node
+        GrowNode,         // bucket = old kind, result = new kind
+        ShrinkNode,       // bucket = old kind, result = new kind
+        MergePath,        // result = merged path length
+        CollapseToLeaf,
+        Erased,           // result = size
+        ScanDone          // result = entries, bucket = nodes visited
+    };
+
+    enum Flag : quint16 {
+        Simd = 0x1,   // Node16 edge found with one SSE2 compare
+        Match = 0x2,  // leaf key / terminal matched
+        Scan = 0x4    // step belongs to a prefix or range scan
+    };
+
+    static QString render(const StepEvent &event, const StepLog &log);
+    // Colour class of a row, from the opcode (or the marker of a text row)
+    static StepCategory category(const StepEvent &event, const StepLog &log);
+
+    // Labels shared with the page's drawing
+    static QString kindName(int kind);
+    static QString byteText(int byte);
+    static QString pathText(const QByteArray &path);
+};
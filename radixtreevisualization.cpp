@@ -0,0 +1,704 @@
+#include "radixtreevisualization.h"
+#include <QTextDocument>
+#include <QTextOption>
+#include <functional>
+
+// Define static constants
+const int RadixTreeVisualization::NODE_WIDTH = 90;
+const int RadixTreeVisualization::NODE_HEIGHT = 46;
+const int RadixTreeVisualization::NODE_SPACING = 14;
+const int RadixTreeVisualization::LEVEL_HEIGHT = 95;
+const int RadixTreeVisualization::MAX_VISIBLE_NODES = 63;
+const int RadixTreeVisualization::MAX_RESULTS = 500;
+
+RadixTreeVisualization::RadixTreeVisualization(QWidget *parent)
+    : QWidget(parent)
+    , stepLog(new StepLog(&RadixTreeTrace::render, &RadixTreeTrace::category))
+    , tree(new Tree(stepLog))
+{
+    setupUI();
+    drawTree();
+    showStats();
+
+    setMinimumSize(1200, 800);
+}
+
+RadixTreeVisualization::~RadixTreeVisualization()
+{
+    delete tree;
+    delete stepLog;
+}
+
+void RadixTreeVisualization::setupUI()
+{
+    // Main splitter for left (visualization) and right (trace) panels
+    mainSplitter = createManagedWidget<QSplitter>(this);
+    mainSplitter->setOrientation(Qt::Horizontal);
+    StyleManager::instance().applySplitterStyle(mainSplitter);
+
+    setupVisualizationArea();
+    setupRightPanel();
+    mainSplitter->addWidget(leftPanel);
+    mainSplitter->addWidget(rightPanel);
+    mainSplitter->setSizes({780, 420});
+
+    QHBoxLayout *mainLayout = new QHBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    mainLayout->addWidget(mainSplitter);
+    setLayout(mainLayout);
+}
+
+void RadixTreeVisualization::setupVisualizationArea()
+{
+    leftPanel = new QWidget();
+    leftPanel->setStyleSheet("background: transparent;");
+    leftLayout = new QVBoxLayout(leftPanel);
+    leftLayout->setContentsMargins(40, 30, 20, 30);
+    leftLayout->setSpacing(25);
+
+    // Header with back button and title
+    QHBoxLayout *headerLayout = new QHBoxLayout();
+
+    backButton = new BackButton(BackButton::BackToOperations);
+    connect(backButton, &BackButton::backRequested, this, &RadixTreeVisualization::onBackClicked);
+    titleLabel = new QLabel("Adaptive Radix Tree");
+    QFont titleFont;
+    QStringList preferredFonts = {"Segoe UI", "Poppins", "SF Pro Display", "Arial"};
+    for (const QString &fontName : preferredFonts) {
+        if (QFontDatabase::families().contains(fontName)) {
+            titleFont.setFamily(fontName);
+            break;
+        }
+    }
+    titleFont.setPointSize(28);
+    titleFont.setBold(true);
+    titleLabel->setFont(titleFont);
+    titleLabel->setStyleSheet("color: #2c3e50; background: transparent;");
+    titleLabel->setAlignment(Qt::AlignCenter);
+
+    headerLayout->addWidget(backButton, 0, Qt::AlignLeft);
+    headerLayout->addStretch();
+    headerLayout->addWidget(titleLabel, 0, Qt::AlignCenter);
+    headerLayout->addStretch();
+    leftLayout->addLayout(headerLayout);
+
+    setupStatsAndControls();
+
+    scene = new QGraphicsScene(this);
+
+    visualizationView = new QGraphicsView(scene);
+    visualizationView->setRenderHint(QPainter::Antialiasing);
+    visualizationView->setMinimumHeight(450);
+    visualizationView->setStyleSheet(R"(
+        QGraphicsView {
+            border: 2px solid rgba(74, 144, 226, 0.2);
+            border-radius: 20px;
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:1,
+                stop:0 rgba(248, 251, 255, 0.98),
+                stop:1 rgba(240, 247, 255, 0.98));
+        }
+    )");
+
+    QGraphicsDropShadowEffect *viewShadow = new QGraphicsDropShadowEffect();
+    viewShadow->setBlurRadius(20);
+    viewShadow->setXOffset(0);
+    viewShadow->setYOffset(6);
+    viewShadow->setColor(QColor(74, 144, 226, 25));
+    visualizationView->setGraphicsEffect(viewShadow);
+
+    leftLayout->addWidget(visualizationView, 1);
+
+    // Bottom note about the node limit
+    nodeNote = new QLabel();
+    nodeNote->setStyleSheet(R"(
+        QLabel {
+            color: #7f8c8d;
+            font-size: 11px;
+            font-style: italic;
+            padding: 5px;
+        }
+    )");
+    nodeNote->setAlignment(Qt::AlignLeft);
+    leftLayout->addWidget(nodeNote);
+}
+
+QPushButton *RadixTreeVisualization::createButton(const QString &text, const QString &from, const QString &to,
+                                                  const QString &hoverFrom, const QString &hoverTo)
+{
+    QPushButton *button = new QPushButton(text);
+    button->setFixedSize(75, 35);
+    button->setCursor(Qt::PointingHandCursor);
+    button->setStyleSheet(QString(R"(
+        QPushButton {
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:1,
+                stop:0 %1, stop:1 %2);
+            color: white;
+            border: none;
+            border-radius: 17px;
+            font-weight: bold;
+            font-size: 10px;
+        }
+        QPushButton:hover {
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:1,
+                stop:0 %3, stop:1 %4);
+        }
+        QPushButton:disabled { background: #cccccc; }
+    )").arg(from, to, hoverFrom, hoverTo));
+    return button;
+}
+
+void RadixTreeVisualization::setupStatsAndControls()
+{
+    QVBoxLayout *topLayout = new QVBoxLayout();
+    topLayout->setSpacing(15);
+
+    // Stats row
+    QHBoxLayout *statsLayout = new QHBoxLayout();
+    statsLayout->setSpacing(15);
+
+    sizeLabel = new QLabel("Size: 0");
+    nodesLabel = new QLabel("Node4: 0 · Node16: 0 · Node48: 0 · Node256: 0");
+    nodesLabel->setToolTip("Inner nodes of each size. A node grows to the next size when it runs out of "
+                           "child slots and shrinks back when enough children are removed.");
+    heightLabel = new QLabel("Height: 0");
+
+    const QString statsStyle = R"(
+        QLabel {
+            color: #34495e;
+            font-weight: bold;
+            font-family: 'Segoe UI';
+            font-size: 12px;
+            padding: 8px 12px;
+            background-color: rgba(74, 144, 226, 0.1);
+            border-radius: 12px;
+            border: 1px solid rgba(74, 144, 226, 0.2);
+        }
+    )";
+    sizeLabel->setStyleSheet(statsStyle);
+    nodesLabel->setStyleSheet(statsStyle);
+    heightLabel->setStyleSheet(statsStyle);
+
+    statsLayout->addWidget(sizeLabel);
+    statsLayout->addWidget(nodesLabel);
+    statsLayout->addWidget(heightLabel);
+    statsLayout->addStretch();
+
+    // Controls row
+    QHBoxLayout *controlLayout = new QHBoxLayout();
+    controlLayout->setSpacing(10);
+
+    const QString inputStyle = R"(
+        QLineEdit {
+            background-color: white;
+            border: 2px solid #d0c5e8;
+            border-radius: 20px;
+            padding: 8px 16px;
+            color: #2d1b69;
+            font-size: 12px;
+        }
+        QLineEdit:focus { border-color: #7b4fff; }
+    )";
+
+    keyInput = new QLineEdit();
+    keyInput->setPlaceholderText("Key / prefix / from");
+    keyInput->setFixedSize(150, 40);
+    keyInput->setStyleSheet(inputStyle);
+
+    valueInput = new QLineEdit();
+    valueInput->setPlaceholderText("Value / to");
+    valueInput->setFixedSize(150, 40);
+    valueInput->setStyleSheet(inputStyle);
+
+    insertButton = createButton("Insert", "#7b4fff", "#9b6fff", "#6c3cff", "#8b5fff");
+    searchButton = createButton("Search", "#4a90e2", "#6bb6ff", "#357abd", "#5ba0e6");
+    deleteButton = createButton("Delete", "#ff6b6b", "#ff8e8e", "#ff5252", "#ff7575");
+    prefixButton = createButton("Prefix", "#f39c12", "#f5b041", "#d68910", "#f39c12");
+    prefixButton->setToolTip("List every key starting with the key box, in order");
+    rangeButton = createButton("Range", "#16a085", "#48c9b0", "#138d75", "#16a085");
+    rangeButton->setToolTip("List every key from the key box (inclusive) to the value box (exclusive), in order");
+    randomizeButton = createButton("Random", "#28a745", "#34ce57", "#218838", "#28a745");
+    clearButton = createButton("Clear", "#95a5a6", "#bdc3c7", "#7f8c8d", "#95a5a6");
+
+    randomCountCombo = new QComboBox();
+    for (int count : {1, 10, 100, 1000}) {
+        randomCountCombo->addItem(QString("×%1").arg(count), count);
+    }
+    randomCountCombo->setFixedHeight(35);
+    randomCountCombo->setToolTip("Words inserted per Random click");
+    randomCountCombo->setStyleSheet(R"(
+        QComboBox {
+            background-color: white;
+            border: 2px solid #d0c5e8;
+            border-radius: 17px;
+            padding: 4px 12px;
+            color: #2d1b69;
+            font-size: 10px;
+            font-weight: bold;
+        }
+        QComboBox:focus { border-color: #28a745; }
+        QComboBox::drop-down { border: none; width: 18px; }
+    )");
+
+    controlLayout->addWidget(keyInput);
+    controlLayout->addWidget(valueInput);
+    controlLayout->addWidget(insertButton);
+    controlLayout->addWidget(deleteButton);
+    controlLayout->addWidget(searchButton);
+    controlLayout->addWidget(prefixButton);
+    controlLayout->addWidget(rangeButton);
+    controlLayout->addWidget(clearButton);
+    controlLayout->addWidget(randomizeButton);
+    controlLayout->addWidget(randomCountCombo);
+    controlLayout->addStretch();
+
+    connect(insertButton, &QPushButton::clicked, this, &RadixTreeVisualization::onInsertClicked);
+    connect(searchButton, &QPushButton::clicked, this, &RadixTreeVisualization::onSearchClicked);
+    connect(deleteButton, &QPushButton::clicked, this, &RadixTreeVisualization::onDeleteClicked);
+    connect(prefixButton, &QPushButton::clicked, this, &RadixTreeVisualization::onPrefixClicked);
+    connect(rangeButton, &QPushButton::clicked, this, &RadixTreeVisualization::onRangeClicked);
+    connect(randomizeButton, &QPushButton::clicked, this, &RadixTreeVisualization::onRandomizeClicked);
+    connect(clearButton, &QPushButton::clicked, this, &RadixTreeVisualization::onClearClicked);
+
+    topLayout->addLayout(statsLayout);
+    topLayout->addLayout(controlLayout);
+    leftLayout->addLayout(topLayout);
+}
+
+void RadixTreeVisualization::setupRightPanel()
+{
+    rightPanel = new QWidget();
+    rightPanel->setMinimumWidth(400);
+    rightPanel->setStyleSheet(R"(
+        QWidget {
+            background: qlineargradient(x1:0, y1:0, x2:0, y2:1,
+                stop:0 rgba(250, 252, 255, 0.9),
+                stop:1 rgba(245, 249, 255, 0.95));
+            border-left: 1px solid rgba(123, 79, 255, 0.1);
+        }
+    )");
+
+    rightLayout = new QVBoxLayout(rightPanel);
+    rightLayout->setContentsMargins(20, 20, 20, 20);
+    rightLayout->setSpacing(15);
+    rightLayout->addSpacing(30);
+
+    traceGroup = new QGroupBox("");
+    traceGroup->setStyleSheet(R"(
+        QGroupBox {
+            border: 3px solid qlineargradient(x1:0, y1:0, x2:1, y2:0,
+                stop:0 rgba(138, 43, 226, 0.6),
+                stop:0.5 rgba(30, 144, 255, 0.6),
+                stop:1 rgba(0, 191, 255, 0.6));
+            border-radius: 20px;
+            margin-top: 15px;
+            padding-top: 15px;
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:1,
+                stop:0 rgba(240, 248, 255, 0.98),
+                stop:0.3 rgba(230, 245, 255, 0.98),
+                stop:0.7 rgba(245, 240, 255, 0.98),
+                stop:1 rgba(250, 245, 255, 0.98));
+        }
+    )");
+
+    QVBoxLayout *traceLayout = new QVBoxLayout(traceGroup);
+    traceLayout->setContentsMargins(20, 20, 20, 20);
+    traceLayout->setSpacing(15);
+
+    QLabel *traceTitle = new QLabel("🔤 Radix Tree Operations & Scans");
+    traceTitle->setStyleSheet(R"(
+        QLabel {
+            font-weight: bold;
+            font-size: 16px;
+            color: white;
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:0,
+                stop:0 rgba(138, 43, 226, 0.9),
+                stop:0.5 rgba(30, 144, 255, 0.9),
+                stop:1 rgba(0, 191, 255, 0.9));
+            border-radius: 15px;
+            padding: 10px 25px;
+            margin: 5px;
+        }
+    )");
+    traceTitle->setAlignment(Qt::AlignCenter);
+    traceLayout->addWidget(traceTitle);
+
+    traceTabWidget = new QTabWidget();
+    traceTabWidget->setStyleSheet(R"(
+        QTabWidget::pane {
+            border: 2px solid rgba(123, 79, 255, 0.2);
+            border-radius: 10px;
+            background: white;
+            margin-top: 5px;
+        }
+        QTabWidget::tab-bar {
+            alignment: center;
+        }
+        QTabBar::tab {
+            background: rgba(123, 79, 255, 0.1);
+            color: #2d1b69;
+            padding: 8px 16px;
+            margin: 2px;
+            border-radius: 8px;
+            font-weight: bold;
+            font-size: 12px;
+        }
+        QTabBar::tab:selected {
+            background: qlineargradient(x1:0, y1:0, x2:0, y2:1,
+                stop:0 rgba(123, 79, 255, 0.8),
+                stop:1 rgba(155, 89, 182, 0.8));
+            color: white;
+        }
+        QTabBar::tab:hover:!selected {
+            background: rgba(123, 79, 255, 0.2);
+        }
+    )");
+
+    stepsList = new QListView();
+    StyleManager::instance().applyStepTraceStyle(stepsList);
+    stepsList->setUniformItemSizes(true);
+    stepsModel = new StepListModel(stepLog, this);
+    stepsModel->setCategoryColor(StepCategory::Success, QColor(39, 174, 96));
+    stepsModel->setCategoryColor(StepCategory::Failure, QColor(231, 76, 60));
+    stepsModel->setCategoryColor(StepCategory::Search, QColor(52, 152, 219));
+    stepsModel->setCategoryColor(StepCategory::Insert, QColor(46, 125, 50));
+    stepsModel->setCategoryColor(StepCategory::Delete, QColor(211, 47, 47));
+    stepsModel->setCategoryColor(StepCategory::Calculate, QColor(155, 89, 182));
+    stepsList->setModel(stepsModel);
+    resultsList = new QListWidget();
+    StyleManager::instance().applyStepTraceStyle(resultsList);
+
+    traceTabWidget->addTab(stepsList, "📝 Steps");
+    traceTabWidget->addTab(resultsList, "📋 Results");
+
+    traceLayout->addWidget(traceTabWidget);
+    rightLayout->addWidget(traceGroup, 1);
+}
+
+void RadixTreeVisualization::flashInvalid(QLineEdit *input)
+{
+    input->setStyleSheet(input->styleSheet() + "border-color: #dc3545 !important;");
+    QTimer::singleShot(2000, input, [input]() {
+        input->setStyleSheet(input->styleSheet().replace("border-color: #dc3545 !important;", ""));
+    });
+}
+
+void RadixTreeVisualization::beginOperation(RadixTreeTrace::Op op, const QString &first, const QString &second)
+{
+    StepEvent event;
+    event.op = op;
+    if (!first.isNull()) event.key = stepLog->addOperand(first);
+    if (!second.isNull()) event.result = stepLog->addOperand(second);
+    stepLog->append(event);
+}
+
+void RadixTreeVisualization::endOperation()
+{
+    stepLog->appendSeparator();
+    updateStepTrace();
+    drawTree();
+    showStats();
+}
+
+void RadixTreeVisualization::onBackClicked()
+{
+    emit backToOperations();
+}
+
+void RadixTreeVisualization::onInsertClicked()
+{
+    const QString key = keyInput->text().trimmed();
+    const QString value = valueInput->text().trimmed();
+    if (key.isEmpty() || value.isEmpty()) {
+        if (key.isEmpty()) flashInvalid(keyInput);
+        if (value.isEmpty()) flashInvalid(valueInput);
+        return;
+    }
+
+    beginOperation(RadixTreeTrace::BeginPut);
+    tree->put(key, value);
+    highlightedKeys = {key};
+    endOperation();
+
+    keyInput->clear();
+    valueInput->clear();
+}
+
+void RadixTreeVisualization::onSearchClicked()
+{
+    const QString key = keyInput->text().trimmed();
+    if (key.isEmpty()) {
+        flashInvalid(keyInput);
+        return;
+    }
+
+    beginOperation(RadixTreeTrace::BeginSearch);
+    const QString *value = tree->find(key);
+    if (value) {
+        stepLog->appendText(QString("✅ Found! Key '%1' → Value '%2'").arg(key, *value));
+        highlightedKeys = {key};
+    } else {
+        stepLog->appendText(QString("❌ Key '%1' not found").arg(key));
+        highlightedKeys.clear();
+    }
+    endOperation();
+
+    keyInput->clear();
+}
+
+void RadixTreeVisualization::onDeleteClicked()
+{
+    const QString key = keyInput->text().trimmed();
+    if (key.isEmpty()) {
+        flashInvalid(keyInput);
+        return;
+    }
+
+    beginOperation(RadixTreeTrace::BeginDelete);
+    tree->erase(key);
+    highlightedKeys.clear();
+    endOperation();
+
+    keyInput->clear();
+}
+
+void RadixTreeVisualization::onPrefixClicked()
+{
+    // An empty prefix lists every key
+    const QString prefix = keyInput->text().trimmed();
+
+    QVector<QPair<QString, QString>> entries;
+    beginOperation(RadixTreeTrace::BeginPrefixScan, prefix);
+    const int total = tree->forEachWithPrefix(prefix, [&entries](const QString &key, const QString &value) {
+        if (entries.size() < MAX_RESULTS) entries.append({key, value});
+    });
+    showResults(QString("%1 key(s) starting with \"%2\"").arg(total).arg(prefix), entries, total);
+    endOperation();
+}
+
+void RadixTreeVisualization::onRangeClicked()
+{
+    const QString from = keyInput->text().trimmed();
+    const QString to = valueInput->text().trimmed();
+    if (to.isEmpty()) {
+        flashInvalid(valueInput);
+        return;
+    }
+
+    QVector<QPair<QString, QString>> entries;
+    beginOperation(RadixTreeTrace::BeginRangeScan, from, to);
+    const int total = tree->forEachInRange(from, to, [&entries](const QString &key, const QString &value) {
+        if (entries.size() < MAX_RESULTS) entries.append({key, value});
+    });
+    showResults(QString("%1 key(s) in [\"%2\", \"%3\")").arg(total).arg(from, to), entries, total);
+    endOperation();
+}
+
+void RadixTreeVisualization::showResults(const QString &title, const QVector<QPair<QString, QString>> &entries, int total)
+{
+    resultsList->clear();
+    QListWidgetItem *header = new QListWidgetItem(title);
+    header->setForeground(QColor(155, 89, 182));
+    header->setFlags(Qt::NoItemFlags);
+    resultsList->addItem(header);
+
+    highlightedKeys.clear();
+    for (const auto &entry : entries) {
+        resultsList->addItem(QString("%1 → %2").arg(entry.first, entry.second));
+        highlightedKeys.insert(entry.first);
+    }
+    if (total > entries.size()) {
+        QListWidgetItem *more = new QListWidgetItem(QString("… %1 more").arg(total - entries.size()));
+        more->setForeground(QColor(127, 140, 141));
+        more->setFlags(Qt::NoItemFlags);
+        resultsList->addItem(more);
+    }
+    traceTabWidget->setCurrentWidget(resultsList);
+}
+
+QString RadixTreeVisualization::randomWord() const
+{
+    // Words built from a few syllables share prefixes, which is what the tree compresses
+    static const QStringList syllables = {"an", "ar", "be", "ca", "de", "en", "in", "la",
+                                          "ma", "mo", "ne", "ra", "re", "sa", "ta", "to"};
+    QRandomGenerator *rng = QRandomGenerator::global();
+    const int parts = rng->bounded(2, 5);
+    QString word;
+    for (int i = 0; i < parts; ++i) {
+        word += syllables.at(rng->bounded(syllables.size()));
+    }
+    return word;
+}
+
+void RadixTreeVisualization::onRandomizeClicked()
+{
+    const int count = randomCountCombo->currentData().toInt();
+    QRandomGenerator *rng = QRandomGenerator::global();
+
+    beginOperation(RadixTreeTrace::BeginInsert);
+    if (count <= 1) {
+        // A single word is traced step by step
+        const QString word = randomWord();
+        tree->insert(word, QString::number(rng->bounded(1, 1000)));
+        highlightedKeys = {word};
+    } else {
+        tree->muteSteps(true);
+        int added = 0;
+        for (int i = 0; i < count; ++i) {
+            if (tree->insert(randomWord(), QString::number(rng->bounded(1, 1000)))) ++added;
+        }
+        tree->muteSteps(false);
+        stepLog->appendText(QString("➕ Inserted %1 random words: %2 new, %3 already present")
+                                .arg(count).arg(added).arg(count - added));
+        highlightedKeys.clear();
+    }
+    endOperation();
+}
+
+void RadixTreeVisualization::onClearClicked()
+{
+    tree->clear();
+    stepLog->clear();
+    resultsList->clear();
+    highlightedKeys.clear();
+
+    beginOperation(RadixTreeTrace::Cleared);
+    endOperation();
+}
+
+void RadixTreeVisualization::drawTree()
+{
+    scene->clear();
+
+    const QVector<Tree::NodeView> views = tree->nodeViews(MAX_VISIBLE_NODES);
+    if (views.isEmpty()) {
+        QGraphicsTextItem *empty = scene->addText("Empty tree: insert a key to create the root");
+        empty->setDefaultTextColor(QColor(127, 140, 141));
+        empty->setFont(QFont("Segoe UI", 12));
+        nodeNote->setText("* Nodes shown: 0");
+        return;
+    }
+
+    // nodeViews() lists children in key order after their parent
+    QVector<QVector<int>> children(views.size());
+    for (int i = 1; i < views.size(); ++i) {
+        children[views[i].parent].append(i);
+    }
+
+    // Nodes without drawn children take consecutive columns; parents sit
+    // centred over their first and last child
+    QVector<qreal> x(views.size());
+    int nextColumn = 0;
+    std::function<void(int)> place = [&](int i) {
+        if (children[i].isEmpty()) {
+            x[i] = nextColumn++ * (NODE_WIDTH + NODE_SPACING);
+            return;
+        }
+        for (int child : children[i]) place(child);
+        x[i] = (x[children[i].first()] + x[children[i].last()]) / 2;
+    };
+    place(0);
+
+    const QFont labelFont("Segoe UI", 9, QFont::Bold);
+    const QFont edgeFont("Segoe UI", 8);
+
+    // Edges first so the nodes are drawn over them
+    for (int i = 1; i < views.size(); ++i) {
+        const int parent = views[i].parent;
+        const QPointF from(x[parent] + NODE_WIDTH / 2.0, views[parent].level * LEVEL_HEIGHT + NODE_HEIGHT);
+        const QPointF to(x[i] + NODE_WIDTH / 2.0, views[i].level * LEVEL_HEIGHT);
+        scene->addLine(QLineF(from, to), QPen(QColor(123, 79, 255, 120), 2));
+
+        const QString edgeText = views[i].edge < 0 ? QStringLiteral("end") : RadixTreeTrace::byteText(views[i].edge);
+        QGraphicsTextItem *edgeLabel = scene->addText(edgeText, edgeFont);
+        edgeLabel->setDefaultTextColor(QColor(52, 73, 94));
+        const QPointF mid = (from + to) / 2;
+        edgeLabel->setPos(mid.x() - edgeLabel->boundingRect().width() / 2, mid.y() - edgeLabel->boundingRect().height() / 2);
+    }
+
+    for (int i = 0; i < views.size(); ++i) {
+        const Tree::NodeView &view = views[i];
+        const QRectF rect(x[i], view.level * LEVEL_HEIGHT, NODE_WIDTH, NODE_HEIGHT);
+
+        QColor fill;
+        QString text;
+        if (view.kind == RadixNodeKind::Leaf) {
+            fill = highlightedKeys.contains(view.key) ? QColor(39, 174, 96) : QColor(74, 144, 226);
+            text = QString("%1\n%2").arg(view.key, view.value);
+        } else {
+            switch (view.kind) {
+            case RadixNodeKind::Node4: fill = QColor(155, 89, 182); break;
+            case RadixNodeKind::Node16: fill = QColor(123, 79, 255); break;
+            case RadixNodeKind::Node48: fill = QColor(230, 126, 34); break;
+            default: fill = QColor(231, 76, 60); break;
+            }
+            const QString path = RadixTreeTrace::pathText(view.path);
+            text = path.isEmpty() ? RadixTreeTrace::kindName(static_cast<int>(view.kind))
+                                  : QString("%1\n\"%2\"").arg(RadixTreeTrace::kindName(static_cast<int>(view.kind)), path);
+        }
+
+        QGraphicsRectItem *box = scene->addRect(rect, QPen(fill.darker(120), 2), QBrush(fill));
+        box->setToolTip(text);
+        QGraphicsTextItem *label = scene->addText(text, labelFont);
+        label->setDefaultTextColor(Qt::white);
+        label->setTextWidth(NODE_WIDTH);
+        label->document()->setDefaultTextOption(QTextOption(Qt::AlignCenter));
+        label->setPos(rect.left(), rect.center().y() - label->boundingRect().height() / 2);
+    }
+
+    const Tree::Stats stats = tree->stats();
+    const int totalNodes = stats.node4 + stats.node16 + stats.node48 + stats.node256 + stats.leaves;
+    nodeNote->setText(totalNodes > views.size()
+                          ? QString("* Nodes shown: %1 of %2 (top levels)").arg(views.size()).arg(totalNodes)
+                          : QString("* Nodes shown: %1").arg(totalNodes));
+
+    // Fit the whole tree, never zooming in past 1:1
+    QRectF itemsRect = scene->itemsBoundingRect().adjusted(-30, -30, 30, 30);
+    scene->setSceneRect(itemsRect);
+    visualizationView->resetTransform();
+    const QRectF viewport = visualizationView->viewport()->rect();
+    if (itemsRect.width() > viewport.width() || itemsRect.height() > viewport.height()) {
+        visualizationView->fitInView(itemsRect, Qt::KeepAspectRatio);
+    }
+}
+
+void RadixTreeVisualization::showStats()
+{
+    const Tree::Stats stats = tree->stats();
+    sizeLabel->setText(QString("Size: %1").arg(tree->size()));
+    nodesLabel->setText(QString("Node4: %1 · Node16: %2 · Node48: %3 · Node256: %4")
+                            .arg(stats.node4).arg(stats.node16).arg(stats.node48).arg(stats.node256));
+    heightLabel->setText(QString("Height: %1").arg(stats.height));
+    heightLabel->setToolTip(QString("%1 byte(s) held in compressed paths").arg(stats.pathBytes));
+}
+
+void RadixTreeVisualization::updateStepTrace()
+{
+    // Only the rows appended since the last call reach the view
+    stepsModel->sync();
+    stepsList->scrollToBottom();
+}
+
+void RadixTreeVisualization::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // Same lavender background as the other visualization pages
+    QLinearGradient gradient(0, 0, width(), height());
+    gradient.setColorAt(0.0, QColor(250, 247, 255));
+    gradient.setColorAt(0.5, QColor(242, 235, 255));
+    gradient.setColorAt(1.0, QColor(237, 228, 255));
+    painter.fillRect(rect(), gradient);
+
+    QRadialGradient topCircle(width() * 0.2, height() * 0.15, width() * 0.4);
+    topCircle.setColorAt(0.0, QColor(200, 180, 255, 30));
+    topCircle.setColorAt(1.0, QColor(200, 180, 255, 0));
+    painter.fillRect(rect(), topCircle);
+
+    QRadialGradient bottomCircle(width() * 0.8, height() * 0.85, width() * 0.5);
+    bottomCircle.setColorAt(0.0, QColor(180, 150, 255, 25));
+    bottomCircle.setColorAt(1.0, QColor(180, 150, 255, 0));
+    painter.fillRect(rect(), bottomCircle);
+}
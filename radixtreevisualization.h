@@ -0,0 +1,128 @@
+#ifndef RADIXTREEVISUALIZATION_H
+#define RADIXTREEVISUALIZATION_H
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QPushButton>
+#include <QLineEdit>
+#include <QLabel>
+#include <QListWidget>
+#include <QGraphicsView>
+#include <QGraphicsScene>
+#include <QGraphicsRectItem>
+#include <QGraphicsTextItem>
+#include <QSplitter>
+#include <QComboBox>
+#include <QGroupBox>
+#include <QTabWidget>
+#include <QPainter>
+#include <QLinearGradient>
+#include <QFont>
+#include <QFontDatabase>
+#include <QTimer>
+#include <QRandomGenerator>
+#include <QGraphicsDropShadowEffect>
+#include <QScrollBar>
+#include <QSet>
+#include "radixtree.h"
+#include "steplistmodel.h"
+#include "backbutton.h"
+#include "stylemanager.h"
+#include "widgetmanager.h"
+
+// Adaptive radix tree page: string keys and values, point operations plus
+// ordered prefix and range scans, with the tree drawn node by node
+class RadixTreeVisualization : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit RadixTreeVisualization(QWidget *parent = nullptr);
+    ~RadixTreeVisualization();
+
+signals:
+    void backToOperations();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private slots:
+    void onBackClicked();
+    void onInsertClicked();
+    void onSearchClicked();
+    void onDeleteClicked();
+    void onPrefixClicked();
+    void onRangeClicked();
+    void onRandomizeClicked();
+    void onClearClicked();
+
+private:
+    using Tree = AdaptiveRadixTree<QString>;
+
+    void setupUI();
+    void setupVisualizationArea();
+    void setupStatsAndControls();
+    void setupRightPanel();
+    QPushButton *createButton(const QString &text, const QString &from, const QString &to,
+                              const QString &hoverFrom, const QString &hoverTo);
+    void flashInvalid(QLineEdit *input);
+    void beginOperation(RadixTreeTrace::Op op, const QString &first = QString(), const QString &second = QString());
+    void endOperation();
+    void showResults(const QString &title, const QVector<QPair<QString, QString>> &entries, int total);
+    void drawTree();
+    void showStats();
+    void updateStepTrace();
+    QString randomWord() const;
+
+    // UI Components
+    QSplitter *mainSplitter;
+    QWidget *leftPanel;
+    QWidget *rightPanel;
+    QVBoxLayout *leftLayout;
+    QVBoxLayout *rightLayout;
+    BackButton *backButton;
+    QLabel *titleLabel;
+    QGraphicsView *visualizationView;
+    QGraphicsScene *scene;
+    QLabel *nodeNote;
+
+    // Controls; Range reads the key box as the lower and the value box as the upper bound
+    QLineEdit *keyInput;
+    QLineEdit *valueInput;
+    QPushButton *insertButton;
+    QPushButton *searchButton;
+    QPushButton *deleteButton;
+    QPushButton *prefixButton;
+    QPushButton *rangeButton;
+    QPushButton *randomizeButton;
+    QComboBox *randomCountCombo;
+    QPushButton *clearButton;
+
+    // Stats
+    QLabel *sizeLabel;
+    QLabel *nodesLabel;
+    QLabel *heightLabel;
+
+    // Step trace and scan results
+    QGroupBox *traceGroup;
+    QTabWidget *traceTabWidget;
+    QListView *stepsList;
+    StepListModel *stepsModel;
+    QListWidget *resultsList;
+
+    // Data
+    StepLog *stepLog;
+    Tree *tree;
+    QSet<QString> highlightedKeys;  // leaves drawn highlighted after a search or scan
+
+    // Constants
+    static const int NODE_WIDTH;
+    static const int NODE_HEIGHT;
+    static const int NODE_SPACING;
+    static const int LEVEL_HEIGHT;
+    static const int MAX_VISIBLE_NODES;
+    static const int MAX_RESULTS;  // scan results listed in the Results tab
+};
+
+#endif // RADIXTREEVISUALIZATION_H
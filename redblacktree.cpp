@@ -1,4 +1,5 @@
 #include "redblacktree.h"
+#include <QScrollBar>
 
 RedBlackTree::RedBlackTree(QWidget *parent)
     : QWidget(parent)
@@ -359,8 +360,22 @@ void RedBlackTree::setupStepTrace()
     )");
 
     // Steps tab - using StyleManager for beautiful scroll bars
-    stepsList = new QListWidget();
+    stepsList = new QListView();
     StyleManager::instance().applyStepTraceStyle(stepsList);
+    stepsList->setUniformItemSizes(true);
+    stepsModel = new StepListModel(&stepHistory, this);
+    stepsModel->setCategoryColor(StepCategory::Success, QColor("#28a745"));
+    stepsModel->setCategoryColor(StepCategory::Failure, QColor("#dc3545"));
+    stepsModel->setCategoryColor(StepCategory::Search, QColor("#17a2b8"));
+    stepsModel->setCategoryColor(StepCategory::Insert, QColor("#7b4fff"));
+    stepsModel->setCategoryColor(StepCategory::Delete, QColor("#fd7e14"));
+    stepsModel->setCategoryColor(StepCategory::Rotate, QColor("#6f42c1"));
+    stepsModel->setCategoryColor(StepCategory::Recolor, QColor("#e83e8c"));
+    stepsModel->setCategoryColor(StepCategory::Direction, QColor("#20c997"));
+    stepsModel->setCategoryColor(StepCategory::Plain, QColor("#6c757d"));
+    stepsModel->setCategoryColor(StepCategory::Separator, QColor("#cccccc"));
+    stepsModel->setSeparatorFont(QFont("Segoe UI", 10, QFont::Bold));
+    stepsList->setModel(stepsModel);
 
     // Algorithm tab - using StyleManager for beautiful scroll bars
     algorithmList = new QListWidget();
@@ -416,65 +431,56 @@ void RedBlackTree::setupTraversalControls()
 
 void RedBlackTree::addStepToHistory(const QString &step)
 {
-    stepHistory.append(step);
+    stepHistory.appendText(step);
     updateStepTrace();
 }
 
 void RedBlackTree::addOperationSeparator()
 {
-    stepHistory.append("────────────────────");
+    stepHistory.appendSeparator();
     updateStepTrace();
 }
 
 void RedBlackTree::updateStepTrace()
 {
-    stepsList->clear();
-    
-    for (const QString &step : stepHistory) {
-        QListWidgetItem *item = new QListWidgetItem(step);
-        
-        // Handle separators
-        if (step.contains("────")) {
-            item->setTextAlignment(Qt::AlignCenter);
-            item->setForeground(QColor("#cccccc"));
-            item->setFont(QFont("Segoe UI", 10, QFont::Bold));
-        }
-        // Color code based on step content
-        else if (step.contains("✅") || step.contains("Success") || step.contains("Found")) {
-            item->setForeground(QColor("#28a745"));
-        }
-        else if (step.contains("❌") || step.contains("Error") || step.contains("Failed")) {
-            item->setForeground(QColor("#dc3545"));
-        }
-        else if (step.contains("🔍") || step.contains("Search") || step.contains("Looking")) {
-            item->setForeground(QColor("#17a2b8"));
-        }
-        else if (step.contains("➕") || step.contains("Insert") || step.contains("Add")) {
-            item->setForeground(QColor("#7b4fff"));
-        }
-        else if (step.contains("🗑️") || step.contains("Delete") || step.contains("Remove")) {
-            item->setForeground(QColor("#fd7e14"));
-        }
-        else if (step.contains("🔄") || step.contains("Rotate") || step.contains("Balance")) {
-            item->setForeground(QColor("#6f42c1"));
-        }
-        else if (step.contains("🎨") || step.contains("Color") || step.contains("Red") || step.contains("Black")) {
-            item->setForeground(QColor("#e83e8c"));
-        }
-        else if (step.contains("📍") || step.contains("Position") || step.contains("Direction")) {
-            item->setForeground(QColor("#20c997"));
-        }
-        else {
-            item->setForeground(QColor("#6c757d"));
-        }
-        
-        stepsList->addItem(item);
-    }
+    // Only the rows appended since the last call reach the view
+    stepsModel->sync();
     
     // Auto-scroll to bottom
     stepsList->scrollToBottom();
 }
 
+StepCategory RedBlackTree::categorizeStep(const StepEvent &event, const StepLog &log)
+{
+    // Classified once, when the step is recorded
+    const QString step = log.operand(event.key).toString();
+    if (step.contains("✅") || step.contains("Success") || step.contains("Found")) {
+        return StepCategory::Success;
+    }
+    if (step.contains("❌") || step.contains("Error") || step.contains("Failed")) {
+        return StepCategory::Failure;
+    }
+    if (step.contains("🔍") || step.contains("Search") || step.contains("Looking")) {
+        return StepCategory::Search;
+    }
+    if (step.contains("➕") || step.contains("Insert") || step.contains("Add")) {
+        return StepCategory::Insert;
+    }
+    if (step.contains("🗑️") || step.contains("Delete") || step.contains("Remove")) {
+        return StepCategory::Delete;
+    }
+    if (step.contains("🔄") || step.contains("Rotate") || step.contains("Balance")) {
+        return StepCategory::Rotate;
+    }
+    if (step.contains("🎨") || step.contains("Color") || step.contains("Red") || step.contains("Black")) {
+        return StepCategory::Recolor;
+    }
+    if (step.contains("📍") || step.contains("Position") || step.contains("Direction")) {
+        return StepCategory::Direction;
+    }
+    return StepCategory::Plain;
+}
+
 void RedBlackTree::showAlgorithm(const QString &operation)
 {
     currentOperation = operation;
@@ -28,6 +28,8 @@
 #include "backbutton.h"
 #include "stylemanager.h"
 #include "widgetmanager.h"
+#include "steplog.h"
+#include "steplistmodel.h"
 
 enum Color { RED, BLACK };
 
@@ -133,6 +135,7 @@ private:
     void addStepToHistory(const QString &step);
     void addOperationSeparator();
     void updateStepTrace();
+    static StepCategory categorizeStep(const StepEvent &event, const StepLog &log);
     void showAlgorithm(const QString &operation);
 
     // UI Components - Main View
@@ -159,7 +162,8 @@ private:
     // Right panel components
     QGroupBox *traceGroup;
     QTabWidget *traceTabWidget;
-    QListWidget *stepsList;
+    QListView *stepsList;
+    StepListModel *stepsModel;
     QListWidget *algorithmList;
     
     // Traversal controls
@@ -173,8 +177,8 @@ private:
     RBNode *NIL;  // Sentinel node
 
     // History and step tracking
-    // history vector removed - now using stepHistory QStringList
-    QVector<QString> stepHistory;
+    // Step trace; rows are formatted by stepsModel as they scroll into view
+    StepLog stepHistory{nullptr, &RedBlackTree::categorizeStep};
     QString currentOperation;
 
     // Animation
@@ -0,0 +1,345 @@
+#pragma once
+
+#include "hashmapcore.h"
+
+// Open-addressing hash map using Robin Hood linear probing.
+// Entries live in one flat slot array. On insert, an entry that has probed
+// further than the resident of a slot takes that slot and the resident moves
+// on, which keeps probe sequences short and uniform. Erase uses backward-shift
+// deletion, so no tombstones are needed.
+template <typename K, typename V, typename Tracer = StepTrace>
+class RobinHoodHashMap : private HashMapStepRecorder<K, V, Tracer> {
+    using Recorder = HashMapStepRecorder<K, V, Tracer>;
+    using typename Recorder::KeyTraits;
+    using typename Recorder::ValueTraits;
+    using Recorder::addStep;
+    using Recorder::addEntryStep;
+    using Recorder::addValueStep;
+    using Recorder::addUpdateStep;
+    using Recorder::addGrowStep;
+    using Recorder::addHashSteps;
+    using Recorder::addCompareStep;
+    using Recorder::runBatch;
+    using Recorder::muteSteps;
+    using Recorder::markDirty;
+    using Recorder::markAllDirty;
+    using Recorder::keyHash;
+    using Recorder::hashStrategy_;
+
+public:
+    using KeyType = K;
+    using ValueType = V;
+    using Recorder::takeDirtyBuckets;
+
+    // Growth always rebuilds the whole slot array in one step
+    static constexpr bool supportsIncrementalRehash = false;
+    static constexpr bool tracksKickChains = false;
+
+    explicit RobinHoodHashMap(int initialBucketCount = 16, const HashMapGrowthPolicy &policy = {},
+                              StepLog *steps = nullptr)
+        : Recorder(steps),
+        slots_(static_cast<size_t>(sanitize(policy).roundedCount(initialBucketCount))),
+        policy_(sanitize(policy)) {}
+
+    // Insert without overwriting; returns true if a new key was added
+    bool insert(const K &key, const V &value) {
+        maybeGrow();
+        return emplaceOrAssign(key, value, keyHash(key), /*assignIfExists=*/false);
+    }
+
+    // Insert or overwrite; returns true if a new key was added
+    bool put(const K &key, const V &value) {
+        maybeGrow();
+        return emplaceOrAssign(key, value, keyHash(key), /*assignIfExists=*/true);
+    }
+
+    // Bulk insert (or put, with assignIfExists) of count pairs. The slot
+    // array is presized once and per-key steps are not recorded. Returns
+    // the number of new keys.
+    int insertBatch(const K *keys, const V *values, int count, bool assignIfExists) {
+        if (count <= 0) return 0;
+        int added = 0;
+        muteSteps(true);
+        reserve(numElements_ + count);
+        runBatch(keys, count, [this](const K &key) { return keyHash(key); },
+                 [this](size_t hash) { prefetchHome(hash); },
+                 [&](int i, size_t hash) {
+                     maybeGrow();
+                     if (emplaceOrAssign(keys[i], values[i], hash, assignIfExists)) ++added;
+                 });
+        muteSteps(false);
+        return added;
+    }
+
+    // Bulk lookup: out[i] receives the value stored for keys[i], or nullptr
+    void findBatch(const K *keys, int count, const V **out) {
+        if (count <= 0) return;
+        muteSteps(true);
+        runBatch(keys, count, [this](const K &key) { return keyHash(key); },
+                 [this](size_t hash) { prefetchHome(hash); },
+                 [&](int i, size_t hash) { out[i] = findHashed(keys[i], hash); });
+        muteSteps(false);
+    }
+
+    // Returns a pointer to the stored value, or nullptr if absent. Q is K or
+    // any type KeyTraits can hash and K compares equal to (QStringView).
+    template <typename Q>
+    const V *find(const Q &key) {
+        return findHashed(key, keyHash(key));
+    }
+
+    template <typename Q>
+    bool erase(const Q &key) {
+        const size_t hash = keyHash(key);
+        const int home = indexForHash(hash, bucketCount());
+        addHashSteps(key, hash, bucketCount(), home, policy_.reducer);
+        addStep(HashMapTrace::Visit, home, 0, HashMapTrace::SlotUnit);
+
+        int pos = locate(key, hash, home);
+        if (pos < 0) {
+            addStep(HashMapTrace::ProbeEnd, -1, 0, HashMapTrace::ForErase);
+            return false;
+        }
+
+        // Backward-shift: pull every displaced successor one slot closer to home
+        int next = nextSlot(pos);
+        while (slots_[static_cast<size_t>(next)].psl > 1) {
+            Slot &from = slots_[static_cast<size_t>(next)];
+            addEntryStep(HashMapTrace::ShiftBack, from.key, from.value, next, 0, static_cast<quint64>(pos));
+            slots_[static_cast<size_t>(pos)] = std::move(from);
+            --slots_[static_cast<size_t>(pos)].psl;
+            markDirty(pos);
+            pos = next;
+            next = nextSlot(pos);
+        }
+        slots_[static_cast<size_t>(pos)] = Slot();
+        markDirty(pos);
+        --numElements_;
+        addStep(HashMapTrace::Erased, bucketCount(), numElements_, HashMapTrace::SlotUnit);
+        maybeShrink();
+        return true;
+    }
+
+    void clear() {
+        std::fill(slots_.begin(), slots_.end(), Slot());
+        numElements_ = 0;
+        markAllDirty();
+    }
+
+    void rehash(int newBucketCount) {
+        newBucketCount = policy_.roundedCount(std::max(newBucketCount, numElements_ + 1));
+        addStep(HashMapTrace::Rehash, newBucketCount, 0, HashMapTrace::SlotUnit);
+        markAllDirty();
+
+        std::vector<Slot> oldSlots(static_cast<size_t>(newBucketCount));
+        oldSlots.swap(slots_);
+        for (Slot &slot : oldSlots) {
+            if (slot.psl == 0) continue;
+            const int home = indexForHash(slot.hash, newBucketCount);
+            const int newIndex = place(std::move(slot.key), std::move(slot.value), slot.hash, home);
+            const Slot &moved = slots_[static_cast<size_t>(newIndex)];
+            addEntryStep(HashMapTrace::Move, moved.key, moved.value, newIndex, HashMapTrace::SlotUnit);
+        }
+    }
+
+    // Grows the slot array now so that n entries fit under the max load factor
+    void reserve(int n) {
+        const int needed = policy_.bucketsFor(n);
+        if (needed > bucketCount()) rehash(needed);
+    }
+
+    // A new reducer changes every home slot, so the slots are re-placed
+    void setGrowthPolicy(const HashMapGrowthPolicy &policy) {
+        const bool reindex = policy.reducer != policy_.reducer;
+        policy_ = sanitize(policy);
+        if (reindex) rehash(bucketCount());
+    }
+
+    int size() const { return numElements_; }
+    int bucketCount() const { return static_cast<int>(slots_.size()); }
+
+    float loadFactor() const {
+        if (slots_.empty()) return 0.0f;
+        return static_cast<float>(numElements_) / static_cast<float>(slots_.size());
+    }
+
+    size_t hashOf(const K &key) const { return keyHash(key); }
+
+    int indexFor(const K &key, int bucketCount) const {
+        return indexForHash(keyHash(key), bucketCount);
+    }
+
+    // Switching the hash function recomputes every stored hash and
+    // re-places all entries at the current size
+    void setHashStrategy(const HashStrategy &strategy) {
+        if (strategy == hashStrategy_) return;
+        hashStrategy_ = strategy;
+        for (Slot &slot : slots_) {
+            if (slot.psl > 0) slot.hash = keyHash(slot.key);
+        }
+        if (numElements_ > 0) rehash(bucketCount());
+    }
+
+    // Entries per home slot (the slot each key hashes to, not where it sits)
+    QVector<int> homeBucketCounts() const {
+        QVector<int> counts(bucketCount(), 0);
+        for (const Slot &slot : slots_) {
+            if (slot.psl > 0) ++counts[indexForHash(slot.hash, bucketCount())];
+        }
+        return counts;
+    }
+
+    // Probe-sequence length per slot: 1 for an entry in its home slot,
+    // +1 for every slot it was displaced by, 0 for an empty slot
+    QVector<int> bucketSizes() const {
+        QVector<int> sizes;
+        sizes.reserve(bucketCount());
+        for (const Slot &slot : slots_) {
+            sizes.push_back(slot.psl);
+        }
+        return sizes;
+    }
+
+    // Slots per probe-sequence length, built from the slot array in O(slots)
+    QVector<int> chainLengthHistogram() const { return HashMapChainStats::histogramOf(bucketSizes()); }
+    int maxChainLength() const { return chainLengthHistogram().size() - 1; }
+
+    // Visit the entry held in one slot (at most one); returns 1 if visited
+    template <typename Fn>
+    int forEachInBucket(int index, Fn &&fn, int maxEntries = -1) const {
+        const Slot &slot = slots_[static_cast<size_t>(index)];
+        if (slot.psl == 0 || maxEntries == 0) return 0;
+        fn(slot.key, slot.value);
+        return 1;
+    }
+
+    int bucketEntryCount(int index) const { return slots_[static_cast<size_t>(index)].psl > 0 ? 1 : 0; }
+
+private:
+    struct Slot {
+        K key{};
+        V value{};
+        size_t hash = 0;  // full key hash, so rehashing never rehashes keys
+        int psl = 0;      // probe-sequence length; 0 marks an empty slot
+    };
+
+    std::vector<Slot> slots_;
+    int numElements_ = 0;
+    HashMapGrowthPolicy policy_;
+
+    // Open addressing needs at least one free slot to terminate probes
+    static HashMapGrowthPolicy sanitize(const HashMapGrowthPolicy &policy) {
+        return policy.sanitized(0.9f);
+    }
+
+    int indexForHash(size_t hash, int bucketCount) const {
+        return reduceHash(hash, bucketCount, policy_.reducer);
+    }
+
+    void prefetchHome(size_t hash) const {
+        prefetchForRead(&slots_[static_cast<size_t>(indexForHash(hash, bucketCount()))]);
+    }
+
+    int nextSlot(int pos) const {
+        return pos + 1 == bucketCount() ? 0 : pos + 1;
+    }
+
+    template <typename Q>
+    const V *findHashed(const Q &key, size_t hash) {
+        const int home = indexForHash(hash, bucketCount());
+        addHashSteps(key, hash, bucketCount(), home, policy_.reducer);
+        addStep(HashMapTrace::Visit, home, 0, HashMapTrace::SlotUnit | HashMapTrace::Target);
+
+        const int pos = locate(key, hash, home);
+        if (pos < 0) {
+            addStep(HashMapTrace::ProbeEnd);
+            return nullptr;
+        }
+        addValueStep(HashMapTrace::Found, slots_[static_cast<size_t>(pos)].value);
+        return &slots_[static_cast<size_t>(pos)].value;
+    }
+
+    // Slot holding key, or -1. Stops early once the probe has travelled
+    // further than the resident entry: the key would have displaced it.
+    // Keys are only compared when the stored hash matches.
+    template <typename Q>
+    int locate(const Q &key, size_t hash, int home) {
+        int pos = home;
+        for (int psl = 1;; ++psl) {
+            const Slot &slot = slots_[static_cast<size_t>(pos)];
+            if (slot.psl < psl) return -1;
+            const bool hashMatch = slot.hash == hash;
+            const bool match = hashMatch && slot.key == key;
+            addCompareStep(slot.key, match, hashMatch);
+            if (match) return pos;
+            addStep(HashMapTrace::ProbeNext, nextSlot(pos));
+            pos = nextSlot(pos);
+        }
+    }
+
+    // Robin Hood placement of a key known to be absent; returns its final slot
+    int place(K key, V value, size_t hash, int home) {
+        Slot carry{std::move(key), std::move(value), hash, 1};
+        int pos = home;
+        int placedAt = -1;
+        for (;;) {
+            Slot &slot = slots_[static_cast<size_t>(pos)];
+            if (slot.psl == 0) {
+                slot = std::move(carry);
+                markDirty(pos);
+                return placedAt < 0 ? pos : placedAt;
+            }
+            if (slot.psl < carry.psl) {
+                std::swap(slot, carry);
+                markDirty(pos);
+                if (placedAt < 0) placedAt = pos;
+            }
+            pos = nextSlot(pos);
+            ++carry.psl;
+        }
+    }
+
+    void maybeGrow() {
+        const float projected = (static_cast<float>(numElements_) + 1.0f)
+                                / static_cast<float>(slots_.empty() ? 1 : slots_.size());
+        if (projected > policy_.maxLoadFactor) {
+            const int newCount = policy_.grownCount(bucketCount());
+            addGrowStep(projected, policy_.maxLoadFactor, newCount, HashMapTrace::SlotUnit);
+            rehash(newCount);
+        }
+    }
+
+    void maybeShrink() {
+        if (!policy_.shouldShrink(numElements_, bucketCount())) return;
+
+        const int newCount = policy_.shrunkCount(numElements_);
+        if (newCount >= bucketCount()) return;
+        addGrowStep(loadFactor(), policy_.minLoadFactor, newCount, HashMapTrace::SlotUnit | HashMapTrace::Shrink);
+        rehash(newCount);
+    }
+
+    bool emplaceOrAssign(const K &key, const V &value, size_t hash, bool assignIfExists) {
+        const int home = indexForHash(hash, bucketCount());
+        addHashSteps(key, hash, bucketCount(), home, policy_.reducer);
+        addStep(HashMapTrace::Visit, home, 0, HashMapTrace::SlotUnit);
+
+        const int pos = locate(key, hash, home);
+        if (pos >= 0) {
+            Slot &slot = slots_[static_cast<size_t>(pos)];
+            if (assignIfExists) {
+                addUpdateStep(slot.value, value);
+                slot.value = value;
+                markDirty(pos);
+            } else {
+                addStep(HashMapTrace::Duplicate);
+            }
+            return false; // not a new insertion
+        }
+
+        const int placedAt = place(key, value, hash, home);
+        ++numElements_;
+        addStep(HashMapTrace::PlaceEntry, placedAt, slots_[static_cast<size_t>(placedAt)].psl);
+        addStep(HashMapTrace::NewSize, bucketCount(), numElements_);
+        return true;
+    }
+};
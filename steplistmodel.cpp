@@ -0,0 +1,74 @@
+#include "steplistmodel.h"
+
+StepListModel::StepListModel(const StepLog *log, QObject *parent)
+    : QAbstractListModel(parent)
+    , log_(log)
+    , rows_(log->size())
+    , generation_(log->generation())
+{
+    for (QColor &color : colors_) {
+        color = QColor(44, 62, 80);
+    }
+    colors_[static_cast<int>(StepCategory::Separator)] = QColor(189, 195, 199);
+}
+
+void StepListModel::setCategoryColor(StepCategory category, const QColor &color)
+{
+    colors_[static_cast<int>(category)] = color;
+}
+
+void StepListModel::setSeparatorFont(const QFont &font)
+{
+    separatorFont_ = font;
+}
+
+void StepListModel::sync()
+{
+    const int rows = log_->size();
+    if (log_->generation() != generation_ || rows < rows_) {
+        beginResetModel();
+        rows_ = rows;
+        generation_ = log_->generation();
+        endResetModel();
+        return;
+    }
+    if (rows == rows_) return;
+
+    beginInsertRows(QModelIndex(), rows_, rows - 1);
+    rows_ = rows;
+    endInsertRows();
+}
+
+int StepListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows_;
+}
+
+QVariant StepListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows_ || index.row() >= log_->size()) return QVariant();
+    const int row = index.row();
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return log_->text(row);
+    case Qt::ForegroundRole:
+        return colors_[static_cast<int>(log_->category(row))];
+    case Qt::TextAlignmentRole:
+        if (log_->category(row) == StepCategory::Separator) return int(Qt::AlignCenter);
+        return QVariant();
+    case Qt::FontRole:
+        if (log_->category(row) == StepCategory::Separator) return separatorFont_;
+        return QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags StepListModel::flags(const QModelIndex &index) const
+{
+    // Separators are not selectable
+    if (!index.isValid() || index.row() >= log_->size()
+        || log_->category(index.row()) == StepCategory::Separator) return Qt::NoItemFlags;
+    return QAbstractListModel::flags(index);
+}
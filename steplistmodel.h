@@ -0,0 +1,42 @@
+#ifndef STEPLISTMODEL_H
+#define STEPLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QColor>
+#include <QFont>
+#include "steplog.h"
+
+// Read-only list model over a StepLog for the visualizers' Steps tabs.
+// Rows are formatted only when a view asks for them, coloured from the
+// category stored with each row, and new steps are announced with
+// rowsInserted, so a long session costs the same per click as a short one.
+// Spilled rows page in from disk as they scroll into view.
+class StepListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit StepListModel(const StepLog *log, QObject *parent = nullptr);
+
+    // Colour per category, separators included. Separators keep the
+    // view's font unless one is set.
+    void setCategoryColor(StepCategory category, const QColor &color);
+    void setSeparatorFont(const QFont &font);
+
+    // Catches up with the log: inserts the rows appended since the last
+    // call, or resets when the log was cleared in between
+    void sync();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+private:
+    const StepLog *log_;
+    int rows_;
+    quint32 generation_;
+    QColor colors_[static_cast<int>(StepCategory::Count)];
+    QVariant separatorFont_;
+};
+
+#endif // STEPLISTMODEL_H
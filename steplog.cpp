@@ -0,0 +1,230 @@
+#include "steplog.h"
+
+#include <QDir>
+#include <QTemporaryFile>
+#include <QDebug>
+#include <algorithm>
+
+// Rendered rows that left the ring: one UTF-8 line per row in a data file,
+// plus a fixed-size index record per row so any row can be found with a
+// single seek. Rows are read back a page at a time.
+class StepLog::SpillFile {
+public:
+    SpillFile()
+        : data_(QDir::tempPath() + "/advds-steps-XXXXXX.log"),
+        index_(QDir::tempPath() + "/advds-steps-XXXXXX.idx") {
+        ok_ = data_.open() && index_.open();
+        if (!ok_) {
+            qWarning() << "StepLog: cannot open spill file, older steps will be dropped";
+        }
+    }
+
+    void append(const QString &text, quint16 op, StepCategory category) {
+        if (!ok_) return;
+        if (!atEnd_) {
+            data_.seek(dataEnd_);
+            index_.seek(static_cast<qint64>(rows_) * static_cast<qint64>(sizeof(IndexRecord)));
+            atEnd_ = true;
+        }
+        const QByteArray line = text.toUtf8();
+        const IndexRecord record{dataEnd_, static_cast<quint32>(line.size()), op, static_cast<quint16>(category)};
+        data_.write(line);
+        index_.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        dataEnd_ += line.size();
+        ++rows_;
+        if (page_.size() < PageRows) pageFirst_ = -1;  // cached page is now incomplete
+    }
+
+    QString text(int row) {
+        if (!loadPage(row)) return QString();
+        return page_[row - pageFirst_];
+    }
+
+    quint16 op(int row) {
+        if (!loadPage(row)) return TextOp;
+        return pageOps_[row - pageFirst_];
+    }
+
+    StepCategory category(int row) {
+        if (!loadPage(row)) return StepCategory::Plain;
+        return pageCategories_[row - pageFirst_];
+    }
+
+    void clear() {
+        if (!ok_) return;
+        data_.resize(0);
+        index_.resize(0);
+        dataEnd_ = 0;
+        rows_ = 0;
+        atEnd_ = false;
+        pageFirst_ = -1;
+    }
+
+private:
+    struct IndexRecord {
+        qint64 offset;
+        quint32 length;
+        quint16 op;
+        quint16 category;
+    };
+
+    QTemporaryFile data_;
+    QTemporaryFile index_;
+    bool ok_ = false;
+    bool atEnd_ = false;  // file positions are at the append point
+    qint64 dataEnd_ = 0;
+    int rows_ = 0;
+
+    int pageFirst_ = -1;
+    QVector<QString> page_;
+    QVector<quint16> pageOps_;
+    QVector<StepCategory> pageCategories_;
+
+    bool loadPage(int row) {
+        if (!ok_) return false;
+        if (pageFirst_ >= 0 && row >= pageFirst_ && row < pageFirst_ + page_.size()) return true;
+
+        if (row < 0 || row >= rows_) return false;
+
+        data_.flush();
+        index_.flush();
+        atEnd_ = false;
+        const int first = row - row % PageRows;
+        const int rows = std::min(PageRows, rows_ - first);
+        QVector<IndexRecord> records(rows);
+        index_.seek(static_cast<qint64>(first) * static_cast<qint64>(sizeof(IndexRecord)));
+        index_.read(reinterpret_cast<char *>(records.data()), rows * static_cast<qint64>(sizeof(IndexRecord)));
+
+        const qint64 begin = records.front().offset;
+        const qint64 end = records.back().offset + records.back().length;
+        data_.seek(begin);
+        const QByteArray bytes = data_.read(end - begin);
+
+        page_.resize(rows);
+        pageOps_.resize(rows);
+        pageCategories_.resize(rows);
+        for (int i = 0; i < rows; ++i) {
+            const IndexRecord &r = records[i];
+            page_[i] = QString::fromUtf8(bytes.constData() + (r.offset - begin), static_cast<int>(r.length));
+            pageOps_[i] = r.op;
+            pageCategories_[i] = static_cast<StepCategory>(r.category);
+        }
+        pageFirst_ = first;
+        return true;
+    }
+};
+
+StepLog::StepLog(Renderer renderer, Categorizer categorizer, int capacity)
+    : ring_(static_cast<size_t>(std::max(2, capacity))),
+    operandMarks_(ring_.size()),
+    categories_(ring_.size()),
+    renderer_(renderer),
+    categorizer_(categorizer) {}
+
+StepLog::~StepLog() = default;
+
+void StepLog::append(const StepEvent &event) {
+    if (count_ == capacity()) {
+        spillOldest(count_ / 2);
+    }
+    const size_t slot = slotFor(count_);
+    ring_[slot] = event;
+    operandMarks_[slot] = operationStart_;
+    ++count_;
+    if (event.op == SeparatorOp) {
+        categories_[slot] = StepCategory::Separator;
+    } else {
+        categories_[slot] = categorizer_ ? categorizer_(event, *this) : StepCategory::Plain;
+    }
+}
+
+void StepLog::appendText(const QString &text) {
+    StepEvent event;
+    event.op = TextOp;
+    event.key = addOperand(text);
+    append(event);
+    // A text row is the only user of its operand; when it is also the first
+    // operand of the operation, later rows need not keep it alive
+    if (event.key == operationStart_) operationStart_ = event.key + 1;
+}
+
+void StepLog::appendSeparator() {
+    StepEvent event;
+    event.op = SeparatorOp;
+    append(event);
+    operationStart_ = operandBase_ + static_cast<qint32>(operands_.size());
+}
+
+qint32 StepLog::addOperand(const QVariant &value) {
+    operands_.push_back(value);
+    return operandBase_ + static_cast<qint32>(operands_.size() - 1);
+}
+
+const QVariant &StepLog::operand(qint32 handle) const {
+    static const QVariant released;
+    const qint32 index = handle - operandBase_;
+    if (handle < 0 || index < 0 || index >= static_cast<qint32>(operands_.size())) return released;
+    return operands_[static_cast<size_t>(index)];
+}
+
+bool StepLog::isSeparator(int row) const {
+    if (row < spilledRows_) {
+        return spill_ && spill_->op(row) == SeparatorOp;
+    }
+    return event(row).op == SeparatorOp;
+}
+
+StepCategory StepLog::category(int row) const {
+    if (row < spilledRows_) {
+        return spill_ ? spill_->category(row) : StepCategory::Plain;
+    }
+    return categories_[slotFor(row - spilledRows_)];
+}
+
+QString StepLog::text(int row) const {
+    if (row < spilledRows_) {
+        return spill_ ? spill_->text(row) : QString();
+    }
+    return renderLive(row - spilledRows_);
+}
+
+QString StepLog::renderLive(int liveIndex) const {
+    const StepEvent &e = ring_[slotFor(liveIndex)];
+    switch (e.op) {
+    case TextOp:
+        return operand(e.key).toString();
+    case SeparatorOp:
+        return separatorText();
+    default:
+        return renderer_ ? renderer_(e, *this) : QString();
+    }
+}
+
+void StepLog::spillOldest(int rows) {
+    if (!spill_) spill_ = std::make_unique<SpillFile>();
+
+    for (int i = 0; i < rows; ++i) {
+        spill_->append(renderLive(i), ring_[slotFor(i)].op, categories_[slotFor(i)]);
+    }
+    head_ = static_cast<int>(slotFor(rows));
+    count_ -= rows;
+    spilledRows_ += rows;
+
+    // Operands are only referenced from within their own operation
+    const qint32 keepFrom = count_ > 0 ? operandMarks_[slotFor(0)] : operationStart_;
+    while (operandBase_ < keepFrom && !operands_.empty()) {
+        operands_.pop_front();
+        ++operandBase_;
+    }
+}
+
+void StepLog::clear() {
+    head_ = 0;
+    count_ = 0;
+    operands_.clear();
+    operandBase_ = 0;
+    operationStart_ = 0;
+    spilledRows_ = 0;
+    ++generation_;
+    if (spill_) spill_->clear();
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QVariant>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// One recorded step: a fixed-size record instead of a formatted sentence.
+// Field meaning beyond op is defined by whoever emits the opcode; the text
+// is produced only when a row is displayed.
+struct StepEvent {
+    quint16 op = 0;
+    quint16 flags = 0;
+    qint32 bucket = -1;   // bucket/slot/group index
+    qint32 key = -1;      // operand handle (see StepLog::addOperand)
+    qint32 result = 0;    // opcode-specific: count, flag or second operand handle
+    quint64 hash = 0;
+};
+
+// Colour class of a row. It is worked out once when the row is appended
+// and kept with it, so step lists never look at the text to style it.
+enum class StepCategory : quint8 {
+    Plain,
+    Separator,
+    Success,
+    Failure,
+    Search,
+    Insert,
+    Delete,
+    Calculate,
+    Direction,
+    Rotate,
+    Recolor,
+    Clear,
+    Count
+};
+
+// Append-only step history shared by the visualizers. The most recent
+// events live in a fixed-capacity ring; when it fills, the oldest half is
+// rendered to an append-only temporary file and read back a page at a time
+// when those rows are displayed. Operands that need more than an int (keys,
+// values, free text) live in a side pool and are referenced by handle; they
+// are released once every event of their operation has left the ring.
+class StepLog {
+public:
+    // Opcodes handled by the log itself; owners number theirs from FirstUserOp
+    enum Op : quint16 {
+        TextOp = 0,       // key = handle of a QString operand
+        SeparatorOp = 1,  // ends an operation
+        FirstUserOp = 16
+    };
+
+    using Renderer = QString (*)(const StepEvent &event, const StepLog &log);
+    // Classifies a row as it is appended; text rows can read their operand
+    using Categorizer = StepCategory (*)(const StepEvent &event, const StepLog &log);
+
+    // Spilled rows are read back in pages of this many rows
+    static constexpr int PageRows = 256;
+
+    explicit StepLog(Renderer renderer = nullptr, Categorizer categorizer = nullptr, int capacity = 8192);
+    ~StepLog();
+
+    StepLog(const StepLog &) = delete;
+    StepLog &operator=(const StepLog &) = delete;
+
+    void append(const StepEvent &event);
+    void appendText(const QString &text);
+    void appendSeparator();
+
+    // Stores a value for later rendering and returns its handle
+    qint32 addOperand(const QVariant &value);
+    const QVariant &operand(qint32 handle) const;
+
+    // Rows are numbered from the oldest recorded step, spilled or not
+    int size() const { return spilledRows_ + count_; }
+    bool isEmpty() const { return size() == 0; }
+    int spilledRows() const { return spilledRows_; }
+    int capacity() const { return static_cast<int>(ring_.size()); }
+
+    // Raw record of a row still in memory (row >= spilledRows())
+    const StepEvent &event(int row) const { return ring_[slotFor(row - spilledRows_)]; }
+    bool isSeparator(int row) const;
+    StepCategory category(int row) const;
+
+    // Formats one row on demand; spilled rows are paged in from disk
+    QString text(int row) const;
+
+    // Drops every row, in memory and on disk
+    void clear();
+    // Bumped by clear(), so views can tell a refilled log from a grown one
+    quint32 generation() const { return generation_; }
+
+    static QString separatorText() { return QStringLiteral("────────────────────"); }
+
+private:
+    class SpillFile;
+
+    std::vector<StepEvent> ring_;
+    std::vector<qint32> operandMarks_;  // first operand of each event's operation
+    std::vector<StepCategory> categories_;
+    int head_ = 0;
+    int count_ = 0;
+
+    std::deque<QVariant> operands_;
+    qint32 operandBase_ = 0;     // handle of operands_.front()
+    qint32 operationStart_ = 0;  // first operand handle of the current operation
+
+    Renderer renderer_;
+    Categorizer categorizer_;
+    int spilledRows_ = 0;
+    quint32 generation_ = 0;
+    std::unique_ptr<SpillFile> spill_;
+
+    size_t slotFor(int liveIndex) const {
+        return static_cast<size_t>((head_ + liveIndex) % capacity());
+    }
+
+    QString renderLive(int liveIndex) const;
+    void spillOldest(int rows);
+};
@@ -144,7 +144,7 @@ QString StyleManager::getSplitterStyle() const
 QString StyleManager::getStepTraceStyle() const
 {
     return R"(
-        QListWidget {
+        QListView {
             background: white;
             border: 1px solid #e0e0e0;
             border-radius: 6px;
@@ -153,12 +153,12 @@ QString StyleManager::getStepTraceStyle() const
             font-size: 12px;
             selection-background-color: rgba(123, 79, 255, 0.2);
         }
-        QListWidget::item {
+        QListView::item {
             padding: 6px;
             border-bottom: 1px solid #f0f0f0;
             color: #495057;
         }
-        QListWidget::item:selected {
+        QListView::item:selected {
             background: rgba(123, 79, 255, 0.1);
             color: #7b4fff;
         }
@@ -207,6 +207,71 @@ QString StyleManager::getStepTraceStyle() const
     )";
 }
 
+QString StyleManager::getLoadFactorStyle() const
+{
+    return R"(
+        QLabel {
+            color: #34495e;
+            font-weight: bold;
+            font-family: 'Segoe UI';
+            font-size: 12px;
+            padding: 8px 12px;
+            background-color: rgba(74, 144, 226, 0.1);
+            border-radius: 12px;
+            border: 1px solid rgba(74, 144, 226, 0.2);
+        }
+        QLabel[loadLevel="nearlyFull"] {
+            color: #856404;
+            background-color: rgba(255, 193, 7, 0.9);
+            border: 1px solid rgba(255, 152, 0, 0.5);
+        }
+        QLabel[loadLevel="full"] {
+            color: #ffffff;
+            background-color: rgba(231, 76, 60, 0.9);
+            border: 1px solid rgba(192, 57, 43, 0.5);
+        }
+    )";
+}
+
+QString StyleManager::getLoadFactorWarningStyle() const
+{
+    return R"(
+        QLabel {
+            color: #856404;
+            font-weight: bold;
+            font-family: 'Segoe UI';
+            font-size: 11px;
+            padding: 6px 10px;
+            background-color: rgba(255, 193, 7, 0.9);
+            border-radius: 10px;
+            border: 1px solid rgba(255, 152, 0, 0.5);
+        }
+        QLabel[loadLevel="full"] {
+            color: #ffffff;
+            background-color: rgba(231, 76, 60, 0.9);
+            border: 1px solid rgba(192, 57, 43, 0.5);
+        }
+    )";
+}
+
+QString StyleManager::getBucketNoteStyle() const
+{
+    return R"(
+        QLabel {
+            color: #7f8c8d;
+            font-size: 11px;
+            font-style: italic;
+            padding: 5px;
+        }
+        QLabel[clipped="true"] {
+            color: #e67e22;
+            font-weight: bold;
+            background-color: rgba(230, 126, 34, 0.1);
+            border-radius: 5px;
+        }
+    )";
+}
+
 void StyleManager::applyTraversalGroupStyle(QGroupBox *groupBox)
 {
     if (groupBox) {
@@ -242,13 +307,54 @@ void StyleManager::applySplitterStyle(QWidget *splitter)
     }
 }
 
-void StyleManager::applyStepTraceStyle(QListWidget *listWidget)
+void StyleManager::applyStepTraceStyle(QListView *listView)
 {
-    if (listWidget) {
-        listWidget->setStyleSheet(getStepTraceStyle());
+    if (listView) {
+        listView->setStyleSheet(getStepTraceStyle());
     }
 }
 
+void StyleManager::applyLoadFactorStyle(QLabel *label)
+{
+    if (label) {
+        label->setStyleSheet(getLoadFactorStyle());
+    }
+}
+
+void StyleManager::applyLoadFactorWarningStyle(QLabel *label)
+{
+    if (label) {
+        label->setStyleSheet(getLoadFactorWarningStyle());
+    }
+}
+
+void StyleManager::applyBucketNoteStyle(QLabel *label)
+{
+    if (label) {
+        label->setStyleSheet(getBucketNoteStyle());
+    }
+}
+
+void StyleManager::setLoadLevel(QWidget *widget, LoadLevel level)
+{
+    static const char *const names[] = {"normal", "nearlyFull", "full"};
+    setStyleState(widget, "loadLevel", QString::fromLatin1(names[static_cast<int>(level)]));
+}
+
+void StyleManager::setBucketNoteClipped(QLabel *label, bool clipped)
+{
+    setStyleState(label, "clipped", clipped ? QStringLiteral("true") : QStringLiteral("false"));
+}
+
+void StyleManager::setStyleState(QWidget *widget, const char *name, const QString &state)
+{
+    if (!widget || widget->property(name).toString() == state) return;
+    widget->setProperty(name, state);
+    // Property selectors are only re-evaluated on polish
+    widget->style()->unpolish(widget);
+    widget->style()->polish(widget);
+}
+
 QFont StyleManager::getPreferredFont(int size, bool bold) const
 {
     QFont font;
@@ -11,6 +11,7 @@
 #include <QLineEdit>
 #include <QFont>
 #include <QFontDatabase>
+#include <QStyle>
 
 class StyleManager
 {
@@ -25,6 +26,14 @@ public:
     QString getOperationButtonStyle(const QString &color) const;
     QString getSplitterStyle() const;
     QString getStepTraceStyle() const;
+
+    // Hash map load factor states. The stylesheets below cover every state
+    // through property selectors, so they are set once and a state change
+    // only repolishes the widget instead of re-parsing CSS.
+    enum class LoadLevel { Normal, NearlyFull, Full };
+    QString getLoadFactorStyle() const;
+    QString getLoadFactorWarningStyle() const;
+    QString getBucketNoteStyle() const;
     
     // Apply styles to widgets
     void applyTraversalGroupStyle(QGroupBox *groupBox);
@@ -32,7 +41,14 @@ public:
     void applyTraversalResultListStyle(QListWidget *listWidget);
     void applyOperationButtonStyle(QPushButton *button, const QString &color);
     void applySplitterStyle(QWidget *splitter);
-    void applyStepTraceStyle(QListWidget *listWidget);
+    void applyStepTraceStyle(QListView *listView);
+    void applyLoadFactorStyle(QLabel *label);
+    void applyLoadFactorWarningStyle(QLabel *label);
+    void applyBucketNoteStyle(QLabel *label);
+
+    // Switch a widget styled above to another state; no-ops when unchanged
+    void setLoadLevel(QWidget *widget, LoadLevel level);
+    void setBucketNoteClipped(QLabel *label, bool clipped);
     
     // Font management
     QFont getPreferredFont(int size = 12, bool bold = false) const;
@@ -42,6 +58,8 @@ private:
     ~StyleManager() = default;
     StyleManager(const StyleManager&) = delete;
     StyleManager& operator=(const StyleManager&) = delete;
+
+    static void setStyleState(QWidget *widget, const char *name, const QString &state);
 };
 
 #endif // STYLEMANAGER_H
@@ -0,0 +1,426 @@
+#pragma once
+
+#include "hashmapcore.h"
+#include <QtAlgorithms>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASHMAP_HAVE_SSE2 1
+#endif
+
+// One 16-slot group of control bytes. A control byte is either a 7-bit tag
+// (H2) of a full slot, or one of the negative EMPTY/DELETED markers, so a
+// single compare over the group finds every candidate slot at once.
+struct SwissGroup {
+    static constexpr int Width = 16;
+    static constexpr int8_t Empty = -128;   // 0b10000000
+    static constexpr int8_t Deleted = -2;   // 0b11111110
+
+    // Bitmask of slots whose control byte equals tag
+    static uint32_t match(const int8_t *ctrl, int8_t tag) {
+#ifdef HASHMAP_HAVE_SSE2
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), group)));
+#else
+        uint32_t mask = 0;
+        for (int i = 0; i < Width; ++i) {
+            if (ctrl[i] == tag) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    static uint32_t matchEmpty(const int8_t *ctrl) {
+        return match(ctrl, Empty);
+    }
+
+    // EMPTY and DELETED are the only control bytes with the sign bit set
+    static uint32_t matchEmptyOrDeleted(const int8_t *ctrl) {
+#ifdef HASHMAP_HAVE_SSE2
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+        return static_cast<uint32_t>(_mm_movemask_epi8(group));
+#else
+        uint32_t mask = 0;
+        for (int i = 0; i < Width; ++i) {
+            if (ctrl[i] < 0) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+};
+
+// Open-addressing hash map in the Swiss-table layout: a control byte array
+// next to the slot array, probed one 16-slot group at a time with SSE2.
+// The mixed hash is split into H1 (starting group) and H2 (7-bit tag); keys
+// are only compared for slots whose tag matches, so most negative lookups
+// never touch key memory.
+template <typename K, typename V, typename Tracer = StepTrace>
+class SwissHashMap : private HashMapStepRecorder<K, V, Tracer> {
+    using Recorder = HashMapStepRecorder<K, V, Tracer>;
+    using typename Recorder::KeyTraits;
+    using typename Recorder::ValueTraits;
+    using Recorder::addStep;
+    using Recorder::addEntryStep;
+    using Recorder::addValueStep;
+    using Recorder::addUpdateStep;
+    using Recorder::addGrowStep;
+    using Recorder::addKeyHashStep;
+    using Recorder::addCompareStep;
+    using Recorder::tracing;
+    using Recorder::runBatch;
+    using Recorder::muteSteps;
+    using Recorder::markDirty;
+    using Recorder::markAllDirty;
+    using Recorder::keyHash;
+    using Recorder::hashStrategy_;
+
+public:
+    using KeyType = K;
+    using ValueType = V;
+    using Recorder::takeDirtyBuckets;
+
+    // Growth always rebuilds the whole slot array in one step
+    static constexpr bool supportsIncrementalRehash = false;
+    static constexpr bool tracksKickChains = false;
+
+    explicit SwissHashMap(int initialBucketCount = 16, const HashMapGrowthPolicy &policy = {},
+                          StepLog *steps = nullptr)
+        : Recorder(steps),
+        policy_(sanitize(policy)) {
+        resize(groupsFor(initialBucketCount));
+    }
+
+    // Insert without overwriting; returns true if a new key was added
+    bool insert(const K &key, const V &value) {
+        maybeGrow();
+        return emplaceOrAssign(key, value, hashKey(key), /*assignIfExists=*/false);
+    }
+
+    // Insert or overwrite; returns true if a new key was added
+    bool put(const K &key, const V &value) {
+        maybeGrow();
+        return emplaceOrAssign(key, value, hashKey(key), /*assignIfExists=*/true);
+    }
+
+    // Bulk insert (or put, with assignIfExists) of count pairs. The table
+    // is presized once and per-key steps are not recorded. Returns the
+    // number of new keys.
+    int insertBatch(const K *keys, const V *values, int count, bool assignIfExists) {
+        if (count <= 0) return 0;
+        int added = 0;
+        muteSteps(true);
+        reserve(numElements_ + count);
+        runBatch(keys, count, [this](const K &key) { return hashKey(key); },
+                 [this](size_t hash) { prefetchGroup(hash); },
+                 [&](int i, size_t hash) {
+                     maybeGrow();
+                     if (emplaceOrAssign(keys[i], values[i], hash, assignIfExists)) ++added;
+                 });
+        muteSteps(false);
+        return added;
+    }
+
+    // Bulk lookup: out[i] receives the value stored for keys[i], or nullptr
+    void findBatch(const K *keys, int count, const V **out) {
+        if (count <= 0) return;
+        muteSteps(true);
+        runBatch(keys, count, [this](const K &key) { return hashKey(key); },
+                 [this](size_t hash) { prefetchGroup(hash); },
+                 [&](int i, size_t hash) { out[i] = findHashed(keys[i], hash); });
+        muteSteps(false);
+    }
+
+    // Returns a pointer to the stored value, or nullptr if absent. Q is K or
+    // any type KeyTraits can hash and K compares equal to (QStringView).
+    template <typename Q>
+    const V *find(const Q &key) {
+        return findHashed(key, hashKey(key));
+    }
+
+    template <typename Q>
+    bool erase(const Q &key) {
+        const size_t hash = hashKey(key);
+        addSplitSteps(key, hash);
+
+        const int slot = locate(key, hash);
+        if (slot < 0) return false;
+
+        // A group that still has an EMPTY byte never ended a probe sequence,
+        // so the slot can go straight back to EMPTY instead of a tombstone
+        const int8_t *groupCtrl = &ctrl_[static_cast<size_t>(slot - slot % SwissGroup::Width)];
+        if (SwissGroup::matchEmpty(groupCtrl)) {
+            ctrl_[static_cast<size_t>(slot)] = SwissGroup::Empty;
+            addStep(HashMapTrace::MarkEmpty, slot);
+        } else {
+            ctrl_[static_cast<size_t>(slot)] = SwissGroup::Deleted;
+            ++deletedCount_;
+            addStep(HashMapTrace::MarkDeleted, slot);
+        }
+        slots_[static_cast<size_t>(slot)] = Slot();
+        markDirty(slot);
+        --numElements_;
+        addStep(HashMapTrace::Erased, bucketCount(), numElements_, HashMapTrace::SlotUnit);
+        maybeShrink();
+        return true;
+    }
+
+    void clear() {
+        std::fill(ctrl_.begin(), ctrl_.end(), SwissGroup::Empty);
+        std::fill(slots_.begin(), slots_.end(), Slot());
+        numElements_ = 0;
+        deletedCount_ = 0;
+        markAllDirty();
+    }
+
+    void rehash(int newBucketCount) {
+        const int groups = groupsFor(std::max(newBucketCount,
+                                              static_cast<int>(numElements_ / policy_.maxLoadFactor) + 1));
+        addStep(HashMapTrace::Rehash, groups * SwissGroup::Width, groups, HashMapTrace::SlotUnit);
+        markAllDirty();
+
+        std::vector<int8_t> oldCtrl;
+        std::vector<Slot> oldSlots;
+        oldCtrl.swap(ctrl_);
+        oldSlots.swap(slots_);
+        resize(groups);
+
+        for (size_t i = 0; i < oldCtrl.size(); ++i) {
+            if (oldCtrl[i] < 0) continue;
+            Slot &entry = oldSlots[i];
+            const int newSlot = claimSlot(hashKey(entry.key));
+            addEntryStep(HashMapTrace::Move, entry.key, entry.value, newSlot, HashMapTrace::SlotUnit);
+            slots_[static_cast<size_t>(newSlot)] = std::move(entry);
+            ++numElements_;
+        }
+    }
+
+    // Grows the table now so that n entries fit under the max load factor
+    void reserve(int n) {
+        const int needed = policy_.bucketsFor(n);
+        if (groupsFor(needed) > groupCount_) rehash(needed);
+    }
+
+    void setGrowthPolicy(const HashMapGrowthPolicy &policy) { policy_ = sanitize(policy); }
+
+    int size() const { return numElements_; }
+    int bucketCount() const { return static_cast<int>(slots_.size()); }
+
+    float loadFactor() const {
+        if (slots_.empty()) return 0.0f;
+        return static_cast<float>(numElements_) / static_cast<float>(slots_.size());
+    }
+
+    size_t hashOf(const K &key) const { return hashKey(key); }
+
+    // First slot of the key's starting group
+    int indexFor(const K &key, int bucketCount) const {
+        const int groups = std::max(1, bucketCount / SwissGroup::Width);
+        return static_cast<int>((hashOf(key) >> 7) % static_cast<size_t>(groups)) * SwissGroup::Width;
+    }
+
+    // Hashes are not stored, so rebuilding at the current size is enough
+    void setHashStrategy(const HashStrategy &strategy) {
+        if (strategy == hashStrategy_) return;
+        hashStrategy_ = strategy;
+        if (numElements_ > 0) rehash(bucketCount());
+    }
+
+    // Entries per home group (the group each key's H1 selects)
+    QVector<int> homeBucketCounts() const {
+        QVector<int> counts(groupCount_, 0);
+        for (size_t i = 0; i < ctrl_.size(); ++i) {
+            if (ctrl_[i] >= 0) ++counts[h1(hashKey(slots_[i].key))];
+        }
+        return counts;
+    }
+
+    // Occupancy per slot: 1 for a full slot, 0 for an empty or deleted one
+    QVector<int> bucketSizes() const {
+        QVector<int> sizes;
+        sizes.reserve(bucketCount());
+        for (int8_t c : ctrl_) {
+            sizes.push_back(c >= 0 ? 1 : 0);
+        }
+        return sizes;
+    }
+
+    // Empty vs full slots (the only lengths a slot has), in O(slots)
+    QVector<int> chainLengthHistogram() const { return HashMapChainStats::histogramOf(bucketSizes()); }
+    int maxChainLength() const { return numElements_ > 0 ? 1 : 0; }
+
+    // Visit the entry held in one slot (at most one); returns 1 if visited
+    template <typename Fn>
+    int forEachInBucket(int index, Fn &&fn, int maxEntries = -1) const {
+        if (ctrl_[static_cast<size_t>(index)] < 0 || maxEntries == 0) return 0;
+        const Slot &slot = slots_[static_cast<size_t>(index)];
+        fn(slot.key, slot.value);
+        return 1;
+    }
+
+    int bucketEntryCount(int index) const { return ctrl_[static_cast<size_t>(index)] >= 0 ? 1 : 0; }
+
+private:
+    struct Slot {
+        K key{};
+        V value{};
+    };
+
+    std::vector<int8_t> ctrl_;
+    std::vector<Slot> slots_;
+    int groupCount_ = 1;
+    int numElements_ = 0;
+    int deletedCount_ = 0;
+    HashMapGrowthPolicy policy_;
+
+    // Probes stop at the first group with an EMPTY byte, so keep some free
+    static HashMapGrowthPolicy sanitize(const HashMapGrowthPolicy &policy) {
+        return policy.sanitized(0.875f);
+    }
+
+    // The strategy's hash is mixed once more: H1 and H2 slice it into
+    // fields, which needs entropy in every bit even for std::hash
+    template <typename Q>
+    size_t hashKey(const Q &key) const { return mixHash(keyHash(key)); }
+
+    static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+    int h1(size_t hash) const {
+        // groupCount_ is a power of two
+        return static_cast<int>((hash >> 7) & static_cast<size_t>(groupCount_ - 1));
+    }
+
+    // Power-of-two group count so triangular probing visits every group
+    static int groupsFor(int slots) {
+        int groups = 1;
+        while (groups * SwissGroup::Width < slots) groups *= 2;
+        return groups;
+    }
+
+    void resize(int groups) {
+        groupCount_ = groups;
+        ctrl_.assign(static_cast<size_t>(groups * SwissGroup::Width), SwissGroup::Empty);
+        slots_.assign(static_cast<size_t>(groups * SwissGroup::Width), Slot());
+        numElements_ = 0;
+        deletedCount_ = 0;
+    }
+
+    const int8_t *groupCtrl(int group) const {
+        return &ctrl_[static_cast<size_t>(group * SwissGroup::Width)];
+    }
+
+    // Control bytes of the first group probed, then its slots
+    void prefetchGroup(size_t hash) const {
+        const int group = h1(hash);
+        prefetchForRead(groupCtrl(group));
+        prefetchForRead(&slots_[static_cast<size_t>(group * SwissGroup::Width)]);
+    }
+
+    template <typename Q>
+    const V *findHashed(const Q &key, size_t hash) {
+        addSplitSteps(key, hash);
+
+        const int slot = locate(key, hash);
+        if (slot < 0) return nullptr;
+        addValueStep(HashMapTrace::Found, slots_[static_cast<size_t>(slot)].value);
+        return &slots_[static_cast<size_t>(slot)].value;
+    }
+
+    template <typename Q>
+    void addSplitSteps(const Q &key, size_t hash) {
+        if (!tracing()) return;
+        addKeyHashStep(key, hash, 0);
+        addStep(HashMapTrace::SplitHash, h1(hash), groupCount_ - 1, 0, hash);
+    }
+
+    // Slot holding key, or -1
+    template <typename Q>
+    int locate(const Q &key, size_t hash) {
+        const int8_t tag = h2(hash);
+        int group = h1(hash);
+        for (int probe = 0; probe < groupCount_; ++probe) {
+            const int8_t *ctrl = groupCtrl(group);
+            uint32_t mask = SwissGroup::match(ctrl, tag);
+            addStep(HashMapTrace::ProbeGroup, group, static_cast<int>(qPopulationCount(mask)));
+            while (mask) {
+                const int slot = group * SwissGroup::Width + static_cast<int>(qCountTrailingZeroBits(mask));
+                const bool match = slots_[static_cast<size_t>(slot)].key == key;
+                addCompareStep(slots_[static_cast<size_t>(slot)].key, match);
+                if (match) return slot;
+                mask &= mask - 1;
+            }
+            if (SwissGroup::matchEmpty(ctrl)) {
+                addStep(HashMapTrace::GroupHasEmpty, group);
+                return -1;
+            }
+            group = (group + probe + 1) & (groupCount_ - 1);
+        }
+        addStep(HashMapTrace::ProbedAll);
+        return -1;
+    }
+
+    // First EMPTY or DELETED slot along the probe sequence; marks it full
+    int claimSlot(size_t hash) {
+        int group = h1(hash);
+        for (int probe = 0;; ++probe) {
+            const uint32_t mask = SwissGroup::matchEmptyOrDeleted(groupCtrl(group));
+            if (mask) {
+                const int slot = group * SwissGroup::Width + static_cast<int>(qCountTrailingZeroBits(mask));
+                if (ctrl_[static_cast<size_t>(slot)] == SwissGroup::Deleted) --deletedCount_;
+                ctrl_[static_cast<size_t>(slot)] = h2(hash);
+                return slot;
+            }
+            group = (group + probe + 1) & (groupCount_ - 1);
+        }
+    }
+
+    void maybeGrow() {
+        // Tombstones lengthen probes just like live entries, so count both
+        const float projected = (static_cast<float>(numElements_ + deletedCount_) + 1.0f)
+                                / static_cast<float>(slots_.size());
+        if (projected > policy_.maxLoadFactor) {
+            // Mostly tombstones: rebuild at the same size to purge them
+            const bool purgeOnly = numElements_ + 1 <= static_cast<int>(policy_.maxLoadFactor * bucketCount() / 2);
+            const int newCount = purgeOnly ? bucketCount() : policy_.grownCount(bucketCount());
+            addGrowStep(projected, policy_.maxLoadFactor, newCount, HashMapTrace::SlotUnit);
+            rehash(newCount);
+        }
+    }
+
+    // The group count stays a power of two, so only shrink when the target
+    // actually needs fewer groups
+    void maybeShrink() {
+        if (!policy_.shouldShrink(numElements_, bucketCount())) return;
+
+        const int newCount = policy_.shrunkCount(numElements_);
+        if (groupsFor(newCount) >= groupCount_) return;
+        addGrowStep(loadFactor(), policy_.minLoadFactor, groupsFor(newCount) * SwissGroup::Width,
+                    HashMapTrace::SlotUnit | HashMapTrace::Shrink);
+        rehash(newCount);
+    }
+
+    bool emplaceOrAssign(const K &key, const V &value, size_t hash, bool assignIfExists) {
+        addSplitSteps(key, hash);
+
+        const int existing = locate(key, hash);
+        if (existing >= 0) {
+            Slot &slot = slots_[static_cast<size_t>(existing)];
+            if (assignIfExists) {
+                addUpdateStep(slot.value, value);
+                slot.value = value;
+                markDirty(existing);
+            } else {
+                addStep(HashMapTrace::Duplicate);
+            }
+            return false; // not a new insertion
+        }
+
+        const int slot = claimSlot(hash);
+        slots_[static_cast<size_t>(slot)] = Slot{key, value};
+        markDirty(slot);
+        ++numElements_;
+        addStep(HashMapTrace::PlaceTagged, slot, h2(hash));
+        addStep(HashMapTrace::NewSize, bucketCount(), numElements_);
+        return true;
+    }
+};
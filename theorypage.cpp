@@ -255,6 +255,18 @@ QString TheoryPage::getDefinition()
                
                "<b>Collision Resolution:</b> Common strategies include chaining (linked lists in buckets) and open addressing "
                "(probing for empty slots). This implementation uses open chaining, where collisions are stored as linked lists within buckets.";
+    } else if (dsName == "Radix Tree") {
+        return "A <b>Radix Tree</b> (trie) stores string keys by their characters: each level of the tree branches on "
+               "the next byte of the key, so a key is found by following its own bytes from the root instead of "
+               "comparing it with other keys. Keys sharing a prefix share the path that spells it.<br><br>"
+
+               "<b>Adaptive Radix Tree (ART):</b><br>"
+               "• <b>Adaptive Nodes:</b> Inner nodes come in four sizes (Node4, Node16, Node48, Node256) and grow or shrink with their number of children<br>"
+               "• <b>Path Compression:</b> Chains of single-child nodes are merged into one node that stores the skipped bytes<br>"
+               "• <b>Lazy Expansion:</b> A key that is unique below a node is stored as a leaf right there<br><br>"
+
+               "<b>Ordering:</b> Children are visited in byte order, so walking the tree yields the keys sorted. "
+               "Prefix and range queries descend to the matching subtree and read it in order, with no sorting step.";
     }
     return "Information not available.";
 }
@@ -300,6 +312,16 @@ QString TheoryPage::getTimeComplexity()
                "<b>Average Case:</b> With a good hash function and proper load factor management, operations are O(1)<br>"
                "<b>Worst Case:</b> Poor hash function or high load factor can cause all keys to hash to the same bucket, "
                "degrading to O(n) performance";
+    } else if (dsName == "Radix Tree") {
+        return "<b>Search:</b> O(k) where k is the key length - independent of the number of keys<br>"
+               "<b>Insertion:</b> O(k) - at most one node split and one node growth<br>"
+               "<b>Deletion:</b> O(k) - at most one node shrink and one path merge<br>"
+               "<b>Prefix Query:</b> O(p + m) for a prefix of length p and m matching keys<br>"
+               "<b>Range Query:</b> O(k + m) for m keys in the range, returned already sorted<br>"
+               "<b>Space Complexity:</b> O(n) - adaptive nodes avoid the 256-pointer node of a plain trie<br><br>"
+
+               "<b>SIMD Search:</b> A Node16 compares the searched byte against all 16 of its keys in a single SSE2 "
+               "instruction, so finding a child costs about the same as in a Node4.";
     }
     return "Information not available.";
 }
@@ -340,6 +362,13 @@ QString TheoryPage::getApplications()
                "• <b>Dictionaries:</b> Implementing key-value storage systems (Python dict, JavaScript Map)<br>"
                "• <b>Browser Caching:</b> URL to webpage mapping in web browsers<br>"
                "• <b>Distributed Systems:</b> Consistent hashing for load balancing";
+    } else if (dsName == "Radix Tree") {
+        return "• <b>Main-Memory Databases:</b> Primary and secondary indexes (HyPer, DuckDB)<br>"
+               "• <b>Autocomplete:</b> Returning every word that starts with the typed text<br>"
+               "• <b>IP Routing:</b> Longest-prefix matching of addresses in routing tables<br>"
+               "• <b>Key-Value Stores:</b> Ordered key spaces with range scans<br>"
+               "• <b>File Systems:</b> Path lookup and directory listings<br>"
+               "• <b>Linux Kernel:</b> The page cache indexes pages with a radix tree";
     }
     return "Information not available.";
 }
@@ -375,6 +404,13 @@ QString TheoryPage::getAdvantages()
                "• <b>Key-Value Storage:</b> Ideal for associative arrays and dictionaries<br>"
                "• <b>Universal Support:</b> Widely supported in all major programming languages<br>"
                "• <b>Scalable:</b> Performance remains constant as data grows (in average case)";
+    } else if (dsName == "Radix Tree") {
+        return "• <b>Key-Length Cost:</b> Lookups depend on the key length, not on how many keys are stored<br>"
+               "• <b>Sorted Order:</b> In-order traversal yields the keys sorted, with no rebalancing<br>"
+               "• <b>Prefix Queries:</b> All keys with a given prefix live in one subtree<br>"
+               "• <b>No Hashing:</b> No hash function, collisions or rehashing pauses<br>"
+               "• <b>Compact:</b> Adaptive node sizes and path compression keep memory close to the data size<br>"
+               "• <b>Deterministic Shape:</b> The tree depends only on the keys, not on insertion order";
     }
     return "Information not available.";
 }
@@ -409,6 +445,12 @@ QString TheoryPage::getDisadvantages()
                "• <b>Rehashing Cost:</b> Resizing/rehashing can be expensive (O(n) operation)<br>"
                "• <b>Security Risk:</b> Vulnerable to hash collision attacks (DoS attacks)<br>"
                "• <b>Memory Overhead:</b> May waste memory if load factor is too low";
+    } else if (dsName == "Radix Tree") {
+        return "• <b>Complexity:</b> Four node types plus path compression make it harder to implement than a trie or BST<br>"
+               "• <b>Long Keys:</b> Cost grows with key length, which a hash table avoids for exact lookups<br>"
+               "• <b>Pointer Chasing:</b> Each level is a dependent memory access<br>"
+               "• <b>Byte-Ordered Keys:</b> Keys must be encoded so that byte order matches the desired sort order<br>"
+               "• <b>Sparse Keys:</b> Random keys with few shared prefixes gain little from the tree structure";
     }
     return "Information not available.";
 }
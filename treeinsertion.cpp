@@ -1,4 +1,5 @@
 #include "treeinsertion.h"
+#include <QScrollBar>
 
 TreeInsertion::TreeInsertion(QWidget *parent)
     : QWidget(parent)
@@ -249,8 +250,19 @@ void TreeInsertion::setupStepTrace()
     )");
 
     // Steps tab - using StyleManager for beautiful scroll bars
-    stepsList = new QListWidget();
+    stepsList = new QListView();
     StyleManager::instance().applyStepTraceStyle(stepsList);
+    stepsList->setUniformItemSizes(true);
+    stepsModel = new StepListModel(&stepHistory, this);
+    stepsModel->setCategoryColor(StepCategory::Success, QColor(39, 174, 96));
+    stepsModel->setCategoryColor(StepCategory::Failure, QColor(231, 76, 60));
+    stepsModel->setCategoryColor(StepCategory::Search, QColor(52, 152, 219));
+    stepsModel->setCategoryColor(StepCategory::Insert, QColor(46, 125, 50));
+    stepsModel->setCategoryColor(StepCategory::Delete, QColor(211, 47, 47));
+    stepsModel->setCategoryColor(StepCategory::Calculate, QColor(155, 89, 182));
+    stepsModel->setCategoryColor(StepCategory::Direction, QColor(255, 152, 0));
+    stepsModel->setCategoryColor(StepCategory::Clear, QColor(128, 128, 128));
+    stepsList->setModel(stepsModel);
 
     // Algorithm tab - using StyleManager for beautiful scroll bars
     algorithmList = new QListWidget();
@@ -945,62 +957,37 @@ int TreeInsertion::getTreeHeight(TreeNode *node)
 
 void TreeInsertion::addStepToHistory(const QString &step)
 {
-    stepHistory.append(step);
+    stepHistory.appendText(step);
 }
 
 void TreeInsertion::addOperationSeparator()
 {
     // Add separator like hashmap does
-    stepHistory.append("────────────────────");
+    stepHistory.appendSeparator();
 }
 
 void TreeInsertion::updateStepTrace()
 {
-    stepsList->clear();
-    
-    for (int i = 0; i < stepHistory.size(); ++i) {
-        const QString &step = stepHistory[i];
-        
-        // Handle separator lines like hashmap
-        if (step == "────────────────────") {
-            QListWidgetItem *separator = new QListWidgetItem(step);
-            separator->setTextAlignment(Qt::AlignCenter);
-            separator->setFlags(Qt::NoItemFlags); // Make it non-selectable
-            separator->setForeground(QColor(189, 195, 199));
-            stepsList->addItem(separator);
-            continue;
-        }
-        
-        QListWidgetItem *item = new QListWidgetItem(step);
-        
-        // Style different types of steps
-        if (step.contains("✅")) {
-            item->setForeground(QColor(39, 174, 96)); // Green for success
-        } else if (step.contains("❌")) {
-            item->setForeground(QColor(231, 76, 60)); // Red for failure
-        } else if (step.contains("🔍")) {
-            item->setForeground(QColor(52, 152, 219)); // Blue for search
-        } else if (step.contains("➕")) {
-            item->setForeground(QColor(46, 125, 50)); // Green for insert
-        } else if (step.contains("🗑️")) {
-            item->setForeground(QColor(211, 47, 47)); // Red for delete
-        } else if (step.contains("📊") || step.contains("🎯")) {
-            item->setForeground(QColor(155, 89, 182)); // Purple for calculation
-        } else if (step.contains("⬅️") || step.contains("➡️")) {
-            item->setForeground(QColor(255, 152, 0)); // Orange for direction
-        } else if (step.contains("🧹")) {
-            item->setForeground(QColor(128, 128, 128)); // Gray for clear
-        } else {
-            item->setForeground(QColor(44, 62, 80)); // Default dark color
-        }
-        
-        stepsList->addItem(item);
-    }
+    // Only the rows appended since the last call reach the view
+    stepsModel->sync();
     
     // Auto-scroll to bottom to show latest steps
-    if (stepsList->count() > 0) {
-        stepsList->scrollToBottom();
-    }
+    stepsList->scrollToBottom();
+}
+
+StepCategory TreeInsertion::categorizeStep(const StepEvent &event, const StepLog &log)
+{
+    // Classified once, when the step is recorded
+    const QString step = log.operand(event.key).toString();
+    if (step.contains("✅")) return StepCategory::Success;
+    if (step.contains("❌")) return StepCategory::Failure;
+    if (step.contains("🔍")) return StepCategory::Search;
+    if (step.contains("➕")) return StepCategory::Insert;
+    if (step.contains("🗑️")) return StepCategory::Delete;
+    if (step.contains("📊") || step.contains("🎯")) return StepCategory::Calculate;
+    if (step.contains("⬅️") || step.contains("➡️")) return StepCategory::Direction;
+    if (step.contains("🧹")) return StepCategory::Clear;
+    return StepCategory::Plain;
 }
 
 void TreeInsertion::showAlgorithm(const QString &operation)
@@ -28,6 +28,8 @@
 #include "backbutton.h"
 #include "stylemanager.h"
 #include "widgetmanager.h"
+#include "steplog.h"
+#include "steplistmodel.h"
 
 // Tree Node structure
 struct TreeNode {
@@ -101,6 +103,7 @@ private:
     void addStepToHistory(const QString &step);
     void addOperationSeparator();
     void updateStepTrace();
+    static StepCategory categorizeStep(const StepEvent &event, const StepLog &log);
     void showAlgorithm(const QString &operation);
     
     // Traversal methods
@@ -132,7 +135,8 @@ private:
     // Right panel components
     QGroupBox *traceGroup;
     QTabWidget *traceTabWidget;
-    QListWidget *stepsList;
+    QListView *stepsList;
+    StepListModel *stepsModel;
     QListWidget *algorithmList;
     
     // Traversal controls
@@ -145,7 +149,7 @@ private:
     // Animation and operation tracking
     QTimer *animationTimer;
     QVector<TreeNode*> traversalPath;
-    QVector<QString> stepHistory;
+    StepLog stepHistory{nullptr, &TreeInsertion::categorizeStep};
     int currentTraversalStep;
     bool isAnimating;
     QString currentOperation;